@@ -7,6 +7,8 @@
 
 #include <KDatePicker>
 
+#include <QComboBox>
+#include <QImage>
 #include <QLineEdit>
 #include <QSignalSpy>
 #include <QTest>
@@ -124,6 +126,81 @@ private Q_SLOTS:
         QDate expectedDate{2026, 4, 12};
         QCOMPARE(p.date(), expectedDate);
     }
+
+    void testWeekSelection()
+    {
+        KDatePicker p;
+        p.setDate({2026, 4, 15});
+        auto weekCombo = p.findChild<QComboBox *>();
+        QVERIFY(weekCombo);
+        QCOMPARE(weekCombo->currentText(), QStringLiteral("Week 16"));
+        const int weekCount = weekCombo->count();
+
+        // Within the year only the current week changes
+        p.setDate({2026, 11, 2});
+        QCOMPARE(weekCombo->count(), weekCount);
+        QCOMPARE(weekCombo->currentText(), QStringLiteral("Week 45"));
+
+        // Selecting a week keeps the weekday
+        p.setDate({2026, 4, 15});
+        Q_EMIT weekCombo->activated(5);
+        QCOMPARE(p.date(), QDate(2026, 2, 4));
+
+        // 2027 starts in the last week of 2026
+        p.setDate({2027, 1, 1});
+        QCOMPARE(weekCombo->itemText(0), QStringLiteral("Week 53*"));
+    }
+
+    void testCustomDatePainting()
+    {
+        KDatePicker p;
+        p.setDate({2026, 4, 15});
+        p.resize(p.sizeHint());
+        const QImage plain = p.grab().toImage();
+
+        p.setCustomDatePainting(QDate(2026, 4, 20), QDate(2026, 4, 22), Qt::red, KDatePicker::CircleMode, Qt::yellow);
+        QVERIFY(p.grab().toImage() != plain);
+        p.unsetCustomDatePainting(QDate(2026, 4, 20), QDate(2026, 4, 22));
+        QCOMPARE(p.grab().toImage(), plain);
+
+        p.setCustomDatePainting(QDate(2026, 4, 1), Qt::red, KDatePicker::RectangleMode, Qt::yellow);
+        QVERIFY(p.grab().toImage() != plain);
+        p.unsetCustomDatePainting(QDate(2026, 4, 1));
+        QCOMPARE(p.grab().toImage(), plain);
+    }
+
+    void testCustomDatePaintingProvider()
+    {
+        KDatePicker p;
+        p.setDate({2026, 4, 15});
+        p.resize(p.sizeHint());
+        const QImage plain = p.grab().toImage();
+
+        QList<std::pair<QDate, QDate>> requests;
+        p.setCustomDatePaintingProvider([&requests](const QDate &first, const QDate &last) {
+            requests.append({first, last});
+            return QMap<QDate, KDatePicker::DatePainting>{{first.addDays(20), {Qt::red, KDatePicker::CircleMode, Qt::yellow}}};
+        });
+        QVERIFY(p.grab().toImage() != plain);
+        QCOMPARE(requests.size(), 1);
+        QVERIFY(requests.at(0).first <= QDate(2026, 4, 1));
+        QVERIFY(requests.at(0).second >= QDate(2026, 4, 30));
+
+        // Only asked again for another month
+        p.setDate({2026, 4, 16});
+        p.grab();
+        QCOMPARE(requests.size(), 1);
+        p.setDate({2026, 5, 15});
+        p.grab();
+        QCOMPARE(requests.size(), 2);
+        QVERIFY(requests.at(1).first <= QDate(2026, 5, 1));
+        QVERIFY(requests.at(1).second >= QDate(2026, 5, 31));
+
+        p.setCustomDatePaintingProvider({});
+        p.setDate({2026, 4, 15});
+        QCOMPARE(p.grab().toImage(), plain);
+        QCOMPARE(requests.size(), 2);
+    }
 };
 
 QTEST_MAIN(KDatePickerTest)
@@ -0,0 +1,138 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kdatetable_p.h"
+
+#include <QApplication>
+#include <QImage>
+#include <QTest>
+
+class TestDateTable : public KDateTable
+{
+public:
+    using KDateTable::KDateTable;
+    using KDateTable::posFromDate;
+
+    // The background color of the cell of date, next to its top left corner
+    QColor cellColor(const QDate &date)
+    {
+        const QImage image = grab().toImage();
+        const int pos = posFromDate(date) - 1;
+        const QPoint point((pos % 7) * width() / 7 + 3, (pos / 7 + 1) * height() / 7 + 3);
+        return image.pixelColor(point * image.devicePixelRatio());
+    }
+};
+
+class KDateTableAutoTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QApplication::setStyle(QStringLiteral("Fusion"));
+    }
+
+    void testRangePainting()
+    {
+        TestDateTable table(QDate(2026, 3, 25));
+        table.setLocale(QLocale(QLocale::English, QLocale::UnitedStates));
+        table.resize(350, 350);
+
+        table.setCustomDatePainting(QDate(2026, 3, 10), QDate(2026, 3, 12), Qt::black, KDateTable::RectangleMode, Qt::red);
+        QCOMPARE(table.cellColor(QDate(2026, 3, 10)), QColor(Qt::red));
+        QCOMPARE(table.cellColor(QDate(2026, 3, 12)), QColor(Qt::red));
+        QVERIFY(table.cellColor(QDate(2026, 3, 13)) != QColor(Qt::red));
+
+        table.unsetCustomDatePainting(QDate(2026, 3, 11));
+        QCOMPARE(table.cellColor(QDate(2026, 3, 10)), QColor(Qt::red));
+        QVERIFY(table.cellColor(QDate(2026, 3, 11)) != QColor(Qt::red));
+        QCOMPARE(table.cellColor(QDate(2026, 3, 12)), QColor(Qt::red));
+
+        table.unsetCustomDatePainting(QDate(2026, 1, 1), QDate(2026, 12, 31));
+        QVERIFY(table.cellColor(QDate(2026, 3, 10)) != QColor(Qt::red));
+    }
+
+    void testPrecedence()
+    {
+        TestDateTable table(QDate(2026, 3, 25));
+        table.setLocale(QLocale(QLocale::English, QLocale::UnitedStates));
+        table.resize(350, 350);
+
+        table.setCustomDatePaintingProvider([](const QDate &first, const QDate &last) {
+            QMap<QDate, KDateTable::DatePainting> paintings;
+            for (QDate date = first; date <= last; date = date.addDays(1)) {
+                paintings.insert(date, {Qt::black, KDateTable::RectangleMode, Qt::yellow});
+            }
+            return paintings;
+        });
+        QCOMPARE(table.cellColor(QDate(2026, 3, 5)), QColor(Qt::yellow));
+
+        // Set painting wins over the provider, the most recently set wins
+        table.setCustomDatePainting(QDate(2026, 3, 1), QDate(2026, 3, 20), Qt::black, KDateTable::RectangleMode, Qt::red);
+        QCOMPARE(table.cellColor(QDate(2026, 3, 5)), QColor(Qt::red));
+        table.setCustomDatePainting(QDate(2026, 3, 5), Qt::black, KDateTable::RectangleMode, Qt::blue);
+        QCOMPARE(table.cellColor(QDate(2026, 3, 5)), QColor(Qt::blue));
+        table.setCustomDatePainting(QDate(2026, 3, 4), QDate(2026, 3, 6), Qt::black, KDateTable::RectangleMode, Qt::green);
+        QCOMPARE(table.cellColor(QDate(2026, 3, 5)), QColor(Qt::green));
+        QCOMPARE(table.cellColor(QDate(2026, 3, 7)), QColor(Qt::red));
+        QCOMPARE(table.cellColor(QDate(2026, 3, 21)), QColor(Qt::yellow));
+    }
+
+    void testProviderOncePerMonth()
+    {
+        TestDateTable table(QDate(2026, 3, 25));
+        table.resize(350, 350);
+
+        int calls = 0;
+        QDate requestedFirst;
+        QDate requestedLast;
+        table.setCustomDatePaintingProvider([&](const QDate &first, const QDate &last) {
+            ++calls;
+            requestedFirst = first;
+            requestedLast = last;
+            return QMap<QDate, KDateTable::DatePainting>();
+        });
+
+        table.grab();
+        QCOMPARE(calls, 1);
+        QCOMPARE(requestedFirst.daysTo(requestedLast), 41);
+        QVERIFY(requestedFirst < QDate(2026, 3, 1));
+        QVERIFY(requestedLast > QDate(2026, 3, 31));
+
+        table.setDate(QDate(2026, 3, 2));
+        table.grab();
+        QCOMPARE(calls, 1);
+
+        table.setDate(QDate(2026, 4, 2));
+        table.grab();
+        QCOMPARE(calls, 2);
+    }
+
+    void benchmarkManyRanges()
+    {
+        TestDateTable table(QDate(2026, 1, 1));
+        table.resize(350, 350);
+
+        // Ten thousand busy days, in short ranges over about 40 years
+        const QDate start(2000, 1, 1);
+        for (int i = 0; i < 5000; ++i) {
+            const QDate first = start.addDays(3 * i);
+            table.setCustomDatePainting(first, first.addDays(1), Qt::black, KDateTable::RectangleMode, Qt::red);
+        }
+
+        int month = 0;
+        QBENCHMARK {
+            table.setDate(start.addMonths(month++ % 480));
+            table.grab();
+        }
+    }
+};
+
+QTEST_MAIN(KDateTableAutoTest)
+
+#include "kdatetableautotest.moc"
@@ -0,0 +1,122 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <KFontAction>
+#include <KFontChooser>
+
+#include <QFontComboBox>
+#include <QFontDatabase>
+#include <QSignalSpy>
+#include <QTest>
+
+class KFontActionTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        if (QFontDatabase::families().size() < 2) {
+            QSKIP("Not enough fonts available");
+        }
+    }
+
+    void testFamilies()
+    {
+        QStringList families = QFontDatabase::families();
+        families.sort();
+
+        KFontAction action;
+        QCOMPARE(action.items(), families);
+
+        // From the shared list
+        KFontAction otherAction;
+        QCOMPARE(otherAction.items(), families);
+    }
+
+    void testFixedWidthFonts()
+    {
+        KFontAction action(KFontChooser::FixedWidthFonts);
+        const QStringList items = action.items();
+        for (const QString &family : items) {
+            QVERIFY2(QFontDatabase::isFixedPitch(family), qPrintable(family));
+        }
+
+        QStringList fixedFamilies;
+        const QStringList families = QFontDatabase::families();
+        for (const QString &family : families) {
+            if (QFontDatabase::isFixedPitch(family)) {
+                fixedFamilies.append(family);
+            }
+        }
+        fixedFamilies.sort();
+        QCOMPARE(items, fixedFamilies);
+    }
+
+    void testSharedModel()
+    {
+        KFontAction action;
+        KFontAction otherAction;
+        KFontAction fixedAction(KFontChooser::FixedWidthFonts);
+
+        QWidget parent;
+        auto *comboBox = qobject_cast<QFontComboBox *>(action.requestWidget(&parent));
+        auto *otherComboBox = qobject_cast<QFontComboBox *>(otherAction.requestWidget(&parent));
+        auto *secondComboBox = qobject_cast<QFontComboBox *>(action.requestWidget(&parent));
+        auto *fixedComboBox = qobject_cast<QFontComboBox *>(fixedAction.requestWidget(&parent));
+        QVERIFY(comboBox);
+        QVERIFY(otherComboBox);
+        QVERIFY(secondComboBox);
+        QVERIFY(fixedComboBox);
+
+        // One model per set of filters
+        QCOMPARE(otherComboBox->model(), comboBox->model());
+        QCOMPARE(secondComboBox->model(), comboBox->model());
+        QVERIFY(fixedComboBox->model() != comboBox->model());
+        QCOMPARE(comboBox->count(), action.items().size());
+        QCOMPARE(fixedComboBox->count(), fixedAction.items().size());
+    }
+
+    void testSelectFamily()
+    {
+        KFontAction action;
+        KFontAction otherAction;
+        const QString family = action.items().at(action.items().size() / 2);
+
+        QWidget parent;
+        auto *comboBox = qobject_cast<QFontComboBox *>(action.requestWidget(&parent));
+        auto *otherComboBox = qobject_cast<QFontComboBox *>(otherAction.requestWidget(&parent));
+        QVERIFY(comboBox);
+        QVERIFY(otherComboBox);
+        const QString otherFamily = otherComboBox->currentText();
+
+        // Selected in all widgets of the action, but not in those sharing the model
+        QSignalSpy triggeredSpy(&action, &KSelectAction::textTriggered);
+        action.setFont(family);
+        QCOMPARE(action.font(), family);
+        QCOMPARE(comboBox->currentText(), family);
+        QCOMPARE(otherComboBox->currentText(), otherFamily);
+        QCOMPARE(triggeredSpy.count(), 0);
+
+        // Also in widgets created afterwards
+        auto *secondComboBox = qobject_cast<QFontComboBox *>(action.requestWidget(&parent));
+        QVERIFY(secondComboBox);
+        QCOMPARE(secondComboBox->currentText(), family);
+
+        // Selected by the user
+        const QString userFamily = action.items().constFirst() == family ? action.items().constLast() : action.items().constFirst();
+        comboBox->setCurrentIndex(comboBox->findText(userFamily));
+        QCOMPARE(action.font(), userFamily);
+        QCOMPARE(triggeredSpy.count(), 1);
+        QCOMPARE(triggeredSpy.at(0).at(0).toString(), userFamily);
+        QCOMPARE(otherComboBox->currentText(), otherFamily);
+    }
+};
+
+QTEST_MAIN(KFontActionTest)
+
+#include "kfontactiontest.moc"
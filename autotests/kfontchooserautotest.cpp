@@ -0,0 +1,77 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <KFontChooser>
+
+#include <QListView>
+#include <QTest>
+
+class KFontChooserAutoTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QStringList familyRows(const QListView *view)
+    {
+        QStringList rows;
+        const QAbstractItemModel *model = view->model();
+        for (int row = 0; row < model->rowCount(); ++row) {
+            rows.append(model->index(row, 0).data().toString());
+        }
+        return rows;
+    }
+
+private Q_SLOTS:
+    void testFamilyRows()
+    {
+        KFontChooser chooser;
+        auto *view = chooser.findChild<QListView *>(QStringLiteral("familyListView"));
+        QVERIFY(view);
+
+        // The generic families first, then the others sorted
+        chooser.setFontListItems({QStringLiteral("Zeta"), QStringLiteral("Alpha"), QStringLiteral("Serif"), QStringLiteral("Beta")});
+        QCOMPARE(familyRows(view), QStringList({QStringLiteral("Serif"), QStringLiteral("Alpha"), QStringLiteral("Beta"), QStringLiteral("Zeta")}));
+    }
+
+    void testFixedFontsOnly()
+    {
+        KFontChooser chooser(KFontChooser::FixedFontsOnly);
+        auto *view = chooser.findChild<QListView *>(QStringLiteral("familyListView"));
+        QVERIFY(view);
+
+        const QStringList fixedFamilies = KFontChooser::createFontList(KFontChooser::FixedWidthFonts);
+        const QStringList rows = familyRows(view);
+        QVERIFY(!rows.isEmpty());
+        for (const QString &family : rows) {
+            QVERIFY2(fixedFamilies.contains(family), qPrintable(family));
+        }
+    }
+
+    void testFamilyPreview()
+    {
+        KFontChooser chooser;
+        chooser.setFontListItems({QStringLiteral("Alpha"), QStringLiteral("Beta")});
+        auto *view = chooser.findChild<QListView *>(QStringLiteral("familyListView"));
+        QVERIFY(view);
+        QVERIFY(!chooser.isFamilyPreviewEnabled());
+        const int plainRowHeight = view->sizeHintForRow(0);
+
+        // Room for fonts with larger metrics than the one of the view
+        chooser.setFamilyPreviewEnabled(true);
+        QVERIFY(chooser.isFamilyPreviewEnabled());
+        QVERIFY(view->sizeHintForRow(0) >= view->fontMetrics().height() * 3 / 2);
+        QVERIFY(view->sizeHintForRow(0) >= plainRowHeight);
+
+        chooser.setFamilyPreviewEnabled(false);
+        QVERIFY(!chooser.isFamilyPreviewEnabled());
+        QCOMPARE(view->sizeHintForRow(0), plainRowHeight);
+    }
+};
+
+QTEST_MAIN(KFontChooserAutoTest)
+
+#include "kfontchooserautotest.moc"
@@ -0,0 +1,154 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kfontfamilymodel_p.h"
+
+#include <QApplication>
+#include <QFontDatabase>
+#include <QImage>
+#include <QPainter>
+#include <QSignalSpy>
+#include <QTest>
+
+class KFontFamilyModelTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testSetFamilies()
+    {
+        KFontFamilyModel model;
+        QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+
+        const QStringList displayNames{QStringLiteral("Sans Serif"), QStringLiteral("Foo (Bar)"), QStringLiteral("Baz")};
+        const QStringList rawFamilies{QStringLiteral("sans-serif"), QStringLiteral("Foo [Bar]"), QStringLiteral("Baz")};
+        model.setFamilies(displayNames, rawFamilies);
+        QCOMPARE(resetSpy.count(), 1);
+        QCOMPARE(model.rowCount(), 3);
+        QCOMPARE(model.rowCount(model.index(0)), 0);
+
+        for (int row = 0; row < model.rowCount(); ++row) {
+            const QModelIndex index = model.index(row);
+            QCOMPARE(model.displayName(row), displayNames.at(row));
+            QCOMPARE(model.rawFamily(row), rawFamilies.at(row));
+            QCOMPARE(index.data(Qt::DisplayRole).toString(), displayNames.at(row));
+            QCOMPARE(index.data(Qt::EditRole).toString(), displayNames.at(row));
+            QCOMPARE(index.data(Qt::ToolTipRole).toString(), displayNames.at(row));
+            QCOMPARE(index.data(KFontFamilyModel::RawFamilyRole).toString(), rawFamilies.at(row));
+            QVERIFY(!index.data(Qt::DecorationRole).isValid());
+        }
+
+        QVERIFY(model.displayName(3).isEmpty());
+        QVERIFY(model.rawFamily(-1).isEmpty());
+        QVERIFY(!model.data(QModelIndex()).isValid());
+
+        // Without raw families the display names are used
+        model.setFamilies({QStringLiteral("Baz"), QStringLiteral("Qux")});
+        QCOMPARE(resetSpy.count(), 2);
+        QCOMPARE(model.rowCount(), 2);
+        QCOMPARE(model.rawFamily(0), QStringLiteral("Baz"));
+        QCOMPARE(model.index(1).data(KFontFamilyModel::RawFamilyRole).toString(), QStringLiteral("Qux"));
+
+        model.setFamilies({});
+        QCOMPARE(model.rowCount(), 0);
+    }
+
+    void testEstimatedMaximumTextWidth()
+    {
+        KFontFamilyModel model;
+        const QFontMetrics fm(QApplication::font());
+        QCOMPARE(model.estimatedMaximumTextWidth(fm), 0);
+
+        // More entries than measured, the longest one not first
+        QStringList names;
+        for (int i = 1; i <= 100; ++i) {
+            names.append(QString(i % 100 + 1, QLatin1Char('x')));
+        }
+        model.setFamilies(names);
+        QCOMPARE(model.estimatedMaximumTextWidth(fm), fm.horizontalAdvance(QString(100, QLatin1Char('x'))));
+    }
+
+    void testPreviewEnabled()
+    {
+        KFontFamilyDelegate delegate;
+        QSignalSpy sizeHintSpy(&delegate, &QAbstractItemDelegate::sizeHintChanged);
+        QVERIFY(!delegate.isPreviewEnabled());
+
+        delegate.setPreviewEnabled(true);
+        QVERIFY(delegate.isPreviewEnabled());
+        QCOMPARE(sizeHintSpy.count(), 1);
+
+        delegate.setPreviewEnabled(true);
+        QCOMPARE(sizeHintSpy.count(), 1);
+
+        delegate.setPreviewEnabled(false);
+        QVERIFY(!delegate.isPreviewEnabled());
+        QCOMPARE(sizeHintSpy.count(), 2);
+    }
+
+    void testPreviewSizeHint()
+    {
+        KFontFamilyModel model;
+        model.setFamilies({QApplication::font().family()});
+
+        QStyleOptionViewItem option;
+        option.font = QApplication::font();
+        option.fontMetrics = QFontMetrics(option.font);
+
+        KFontFamilyDelegate delegate;
+        const QSize plainSize = delegate.sizeHint(option, model.index(0));
+        delegate.setPreviewEnabled(true);
+        const QSize previewSize = delegate.sizeHint(option, model.index(0));
+        QCOMPARE(previewSize.width(), plainSize.width());
+        QVERIFY(previewSize.height() >= option.fontMetrics.height() * 3 / 2);
+        QVERIFY(previewSize.height() >= plainSize.height());
+    }
+
+    void testPreviewPaint()
+    {
+        const QStringList families = QFontDatabase::families();
+        if (families.isEmpty()) {
+            QSKIP("No fonts available");
+        }
+
+        KFontFamilyModel model;
+        model.setFamilies(families);
+
+        KFontFamilyDelegate delegate;
+        delegate.setPreviewEnabled(true);
+
+        QStyleOptionViewItem option;
+        option.rect = QRect(0, 0, 300, 40);
+        option.font = QApplication::font();
+        option.fontMetrics = QFontMetrics(option.font);
+        option.palette = QApplication::palette();
+        option.palette.setColor(QPalette::Text, Qt::black);
+        option.state = QStyle::State_Enabled | QStyle::State_Active;
+
+        // Painted twice, the second time from the cache
+        for (int i = 0; i < 2; ++i) {
+            QImage image(option.rect.size(), QImage::Format_ARGB32_Premultiplied);
+            image.fill(Qt::white);
+            {
+                QPainter painter(&image);
+                delegate.paint(&painter, option, model.index(0));
+            }
+
+            bool painted = false;
+            for (int y = 0; y < image.height() && !painted; ++y) {
+                for (int x = 0; x < image.width() && !painted; ++x) {
+                    painted = image.pixel(x, y) != qRgb(255, 255, 255);
+                }
+            }
+            QVERIFY(painted);
+        }
+    }
+};
+
+QTEST_MAIN(KFontFamilyModelTest)
+
+#include "kfontfamilymodeltest.moc"
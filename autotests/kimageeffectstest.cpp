@@ -0,0 +1,190 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kimageeffects_p.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <cstring>
+#include <functional>
+
+using Effect = std::function<void(QImage &)>;
+
+Q_DECLARE_METATYPE(KImageEffects::Implementation)
+Q_DECLARE_METATYPE(Effect)
+
+static QImage randomImage(int width, int height, QImage::Format format = QImage::Format_ARGB32)
+{
+    QImage image(width, height, QImage::Format_ARGB32);
+    QRandomGenerator random(42);
+    for (int y = 0; y < height; ++y) {
+        auto *line = reinterpret_cast<quint32 *>(image.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            line[x] = random.generate();
+        }
+    }
+    return image.convertToFormat(format);
+}
+
+static QString implementationName(KImageEffects::Implementation implementation)
+{
+    switch (implementation) {
+    case KImageEffects::Implementation::Generic:
+        return QStringLiteral("generic");
+    case KImageEffects::Implementation::Sse2:
+        return QStringLiteral("sse2");
+    case KImageEffects::Implementation::Avx2:
+        return QStringLiteral("avx2");
+    case KImageEffects::Implementation::Neon:
+        return QStringLiteral("neon");
+    }
+    return QString();
+}
+
+static QList<std::pair<QString, Effect>> effects()
+{
+    return {
+        {QStringLiteral("grayscale"), [](QImage &image) {
+             KImageEffects::grayscale(image);
+         }},
+        {QStringLiteral("desaturate"), [](QImage &image) {
+             KImageEffects::desaturate(image, 0.5f);
+         }},
+        {QStringLiteral("scaleAlpha"), [](QImage &image) {
+             KImageEffects::scaleAlpha(image, 0.3f);
+         }},
+        {QStringLiteral("tint"), [](QImage &image) {
+             KImageEffects::tint(image, QColor(20, 200, 90), 0.4f);
+         }},
+        {QStringLiteral("darken"), [](QImage &image) {
+             KImageEffects::darken(image, 100 / 255.0f);
+         }},
+    };
+}
+
+class KImageEffectsTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void cleanup()
+    {
+        KImageEffects::setImplementation(KImageEffects::availableImplementations().constLast());
+    }
+
+    void testGeneric()
+    {
+        QVERIFY(KImageEffects::setImplementation(KImageEffects::Implementation::Generic));
+
+        const QImage original = randomImage(17, 5);
+
+        // Same as the loops formerly used by KRatingPainter
+        QImage image = original;
+        KImageEffects::grayscale(image);
+        KImageEffects::scaleAlpha(image, 0.5f);
+        for (int y = 0; y < image.height(); ++y) {
+            for (int x = 0; x < image.width(); ++x) {
+                const QRgb pixel = original.pixel(x, y);
+                const int gray = qGray(pixel);
+                const QRgb expected = qRgba((255 * gray) >> 8, (255 * gray) >> 8, (255 * gray) >> 8, qAlpha(pixel) >> 1);
+                QCOMPARE(image.pixel(x, y), expected);
+            }
+        }
+
+        // Painting black atop leaves the alpha channel alone
+        image = original;
+        KImageEffects::darken(image, 1.0f);
+        for (int y = 0; y < image.height(); ++y) {
+            for (int x = 0; x < image.width(); ++x) {
+                QCOMPARE(image.pixel(x, y), qRgba(0, 0, 0, qAlpha(original.pixel(x, y))));
+            }
+        }
+
+        QCOMPARE(KImageEffects::blended(Qt::white, QColor(0, 0, 0, 0)), QColor(Qt::white));
+        QCOMPARE(KImageEffects::blended(Qt::white, Qt::black), QColor(Qt::black));
+    }
+
+    void testEquivalence_data()
+    {
+        QTest::addColumn<KImageEffects::Implementation>("implementation");
+        QTest::addColumn<Effect>("effect");
+        QTest::addColumn<int>("format");
+
+        const auto implementations = KImageEffects::availableImplementations();
+        for (const auto implementation : implementations) {
+            if (implementation == KImageEffects::Implementation::Generic) {
+                continue;
+            }
+            for (const auto &[name, effect] : effects()) {
+                for (const QImage::Format format : {QImage::Format_ARGB32, QImage::Format_ARGB32_Premultiplied}) {
+                    const QString row = implementationName(implementation) + QLatin1Char('-') + name + QLatin1Char('-') + QString::number(format);
+                    QTest::newRow(qPrintable(row)) << implementation << effect << int(format);
+                }
+            }
+        }
+    }
+
+    void testEquivalence()
+    {
+        QFETCH(KImageEffects::Implementation, implementation);
+        QFETCH(Effect, effect);
+        QFETCH(int, format);
+
+        // Odd sizes, so the remainders of the vector loops are covered
+        const QImage original = randomImage(67, 13, QImage::Format(format));
+
+        QVERIFY(KImageEffects::setImplementation(KImageEffects::Implementation::Generic));
+        QImage expected = original;
+        effect(expected);
+
+        QVERIFY(KImageEffects::setImplementation(implementation));
+        QImage image = original;
+        effect(image);
+        QCOMPARE(image, expected);
+
+        // Scan lines with padding are processed one by one
+        const qsizetype bytesPerLine = original.bytesPerLine() + 12;
+        QByteArray buffer(bytesPerLine * original.height(), Qt::Uninitialized);
+        for (int y = 0; y < original.height(); ++y) {
+            memcpy(buffer.data() + y * bytesPerLine, original.constScanLine(y), original.bytesPerLine());
+        }
+        QImage paddedImage(reinterpret_cast<uchar *>(buffer.data()), original.width(), original.height(), bytesPerLine, QImage::Format(format));
+        effect(paddedImage);
+        QCOMPARE(paddedImage, expected);
+    }
+
+    void benchmark_data()
+    {
+        QTest::addColumn<KImageEffects::Implementation>("implementation");
+        QTest::addColumn<Effect>("effect");
+
+        const auto implementations = KImageEffects::availableImplementations();
+        for (const auto implementation : implementations) {
+            for (const auto &[name, effect] : effects()) {
+                const QString row = implementationName(implementation) + QLatin1Char('-') + name;
+                QTest::newRow(qPrintable(row)) << implementation << effect;
+            }
+        }
+    }
+
+    void benchmark()
+    {
+        QFETCH(KImageEffects::Implementation, implementation);
+        QFETCH(Effect, effect);
+
+        QVERIFY(KImageEffects::setImplementation(implementation));
+        QImage image = randomImage(512, 512);
+        QBENCHMARK {
+            effect(image);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(KImageEffectsTest)
+
+#include "kimageeffectstest.moc"
@@ -0,0 +1,124 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <KLedMatrix>
+
+#include <QImage>
+#include <QList>
+#include <QTest>
+
+class KLedMatrixTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testStates()
+    {
+        KLedMatrix matrix(3, 4);
+        QCOMPARE(matrix.count(), 12);
+        QCOMPARE(matrix.state(5), KLed::Off);
+
+        matrix.setState(1, 2, KLed::On);
+        QCOMPARE(matrix.state(6), KLed::On);
+        QCOMPARE(matrix.state(1, 2), KLed::On);
+
+        matrix.toggle(6);
+        QCOMPARE(matrix.state(1, 2), KLed::Off);
+
+        // Out of range is ignored
+        matrix.setState(12, KLed::On);
+        matrix.setState(0, 4, KLed::On);
+        QCOMPARE(matrix.state(12), KLed::Off);
+        QCOMPARE(matrix.state(0, 4), KLed::Off);
+        QCOMPARE(matrix.state(1, 0), KLed::Off);
+    }
+
+    void testSetStates()
+    {
+        KLedMatrix matrix(2, 3);
+
+        const QList<KLed::State> states{KLed::On, KLed::Off, KLed::On, KLed::On, KLed::On};
+        matrix.setStates(states, 2);
+        QCOMPARE(matrix.state(0), KLed::Off);
+        QCOMPARE(matrix.state(1), KLed::Off);
+        QCOMPARE(matrix.state(2), KLed::On);
+        QCOMPARE(matrix.state(3), KLed::Off);
+        QCOMPARE(matrix.state(4), KLed::On);
+        QCOMPARE(matrix.state(5), KLed::On);
+
+        matrix.setAllStates(KLed::On);
+        for (int i = 0; i < matrix.count(); ++i) {
+            QCOMPARE(matrix.state(i), KLed::On);
+        }
+    }
+
+    void testResize()
+    {
+        KLedMatrix matrix(2, 2);
+        matrix.setState(0, 1, KLed::On);
+        matrix.setState(1, 0, KLed::On);
+
+        // States stay at their row and column
+        matrix.setColumnCount(3);
+        QCOMPARE(matrix.count(), 6);
+        QCOMPARE(matrix.state(0, 1), KLed::On);
+        QCOMPARE(matrix.state(1, 0), KLed::On);
+        QCOMPARE(matrix.state(1, 2), KLed::Off);
+
+        matrix.setRowCount(1);
+        QCOMPARE(matrix.count(), 3);
+        QCOMPARE(matrix.state(0, 1), KLed::On);
+
+        matrix.setColumnCount(1);
+        QCOMPARE(matrix.count(), 1);
+        QCOMPARE(matrix.state(0), KLed::Off);
+    }
+
+    void testSizeHint()
+    {
+        KLedMatrix matrix(3, 4);
+        matrix.setCellSize(QSize(10, 12));
+        QCOMPARE(matrix.sizeHint(), QSize(40, 36));
+    }
+
+    void testPaint()
+    {
+        KLedMatrix matrix(1, 2);
+        matrix.setCellSize(QSize(20, 20));
+        matrix.setColor(Qt::red);
+        matrix.setState(0, KLed::On);
+        matrix.resize(matrix.sizeHint());
+
+        const QImage image = matrix.grab().toImage();
+        const QColor on = image.pixelColor(QPoint(10, 10) * image.devicePixelRatio());
+        const QColor off = image.pixelColor(QPoint(30, 10) * image.devicePixelRatio());
+        // The LED which is on is lighter than the one which is off
+        QVERIFY(on.value() > off.value());
+    }
+
+    void benchmarkSetStates()
+    {
+        KLedMatrix matrix(100, 100);
+        matrix.setCellSize(QSize(8, 8));
+        matrix.resize(matrix.sizeHint());
+
+        QList<KLed::State> states(matrix.count(), KLed::Off);
+        bool on = false;
+        QBENCHMARK {
+            on = !on;
+            for (int i = 0; i < states.size(); i += 2) {
+                states[i] = on ? KLed::On : KLed::Off;
+            }
+            matrix.setStates(states);
+            matrix.repaint();
+        }
+    }
+};
+
+QTEST_MAIN(KLedMatrixTest)
+
+#include "kledmatrixtest.moc"
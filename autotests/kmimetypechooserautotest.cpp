@@ -0,0 +1,71 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <KMimeTypeChooser>
+
+#include <QAbstractItemModel>
+#include <QIcon>
+#include <QTest>
+#include <QTreeView>
+
+class KMimeTypeChooserAutoTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testSelection()
+    {
+        const QStringList selection({QStringLiteral("text/plain"), QStringLiteral("foo/bar")});
+        KMimeTypeChooser chooser(QString(), selection, QStringLiteral("text"), QStringList(), KMimeTypeChooser::Comments | KMimeTypeChooser::Patterns);
+
+        // Known right away, even if the list is still being loaded
+        QCOMPARE(chooser.mimeTypes(), QStringList{QStringLiteral("text/plain")});
+        QVERIFY(chooser.patterns().contains(QStringLiteral("*.txt")));
+
+        const QAbstractItemModel *model = chooser.findChild<QTreeView *>()->model();
+        QTRY_VERIFY(model->rowCount() > 0);
+        QCOMPARE(chooser.mimeTypes(), QStringList{QStringLiteral("text/plain")});
+        QVERIFY(chooser.patterns().contains(QStringLiteral("*.txt")));
+
+        // Groups and MIME types are sorted
+        for (int i = 1; i < model->rowCount(); ++i) {
+            QVERIFY(model->index(i - 1, 0).data().toString() < model->index(i, 0).data().toString());
+        }
+        int textGroupRow = -1;
+        for (int i = 0; i < model->rowCount(); ++i) {
+            const QModelIndex group = model->index(i, 0);
+            if (group.data().toString() == QLatin1String("text")) {
+                textGroupRow = i;
+            }
+            for (int j = 1; j < model->rowCount(group); ++j) {
+                QVERIFY2(model->index(j - 1, 0, group).data().toString() < model->index(j, 0, group).data().toString(),
+                         qPrintable(group.data().toString() + QLatin1Char('/') + model->index(j, 0, group).data().toString()));
+            }
+        }
+        QVERIFY(textGroupRow != -1);
+        QVERIFY(model->rowCount(model->index(textGroupRow, 0)) > 1);
+    }
+
+    void testGroupsToShow()
+    {
+        const QStringList selection({QStringLiteral("text/plain"), QStringLiteral("image/png")});
+        KMimeTypeChooser chooser(QString(), selection, QString(), {QStringLiteral("text")}, 0);
+        QCOMPARE(chooser.mimeTypes(), QStringList{QStringLiteral("text/plain")});
+
+        const QAbstractItemModel *model = chooser.findChild<QTreeView *>()->model();
+        QTRY_COMPARE(model->rowCount(), 1);
+        const QModelIndex group = model->index(0, 0);
+        QCOMPARE(group.data().toString(), QStringLiteral("text"));
+        QVERIFY(model->rowCount(group) > 0);
+        QCOMPARE(model->index(0, 0, group).data(Qt::DecorationRole).metaType(), QMetaType::fromType<QIcon>());
+        QCOMPARE(chooser.mimeTypes(), QStringList{QStringLiteral("text/plain")});
+    }
+};
+
+QTEST_MAIN(KMimeTypeChooserAutoTest)
+
+#include "kmimetypechooserautotest.moc"
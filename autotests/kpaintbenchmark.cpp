@@ -0,0 +1,238 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <KCapacityBar>
+#include <KGradientSelector>
+#include <KLed>
+#include <KRatingPainter>
+#include <KRuler>
+#include <KXYSelector>
+
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+#include <QTest>
+
+// Benchmarks of the widgets which do most of their own painting.
+// All render into offscreen images, so the results can be compared between
+// revisions, e.g. with -callgrind or -tickcounter.
+// Not run as part of the tests, start it manually.
+//
+// The widgets render their caches for the device pixel ratio of their screen,
+// so other ratios are benchmarked by running with e.g. QT_SCALE_FACTOR=1.5.
+
+// Image to render a widget into, at the device pixel ratio the widget paints for
+static QImage targetImage(const QSize &size, qreal devicePixelRatio)
+{
+    QImage image(size * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(devicePixelRatio);
+    image.fill(Qt::transparent);
+    return image;
+}
+
+// A hue/saturation field as drawn by color pickers, expensive to paint
+class ColorFieldSelector : public KXYSelector
+{
+public:
+    using KXYSelector::KXYSelector;
+
+protected:
+    void drawContents(QPainter *painter) override
+    {
+        const QRect rect = contentsRect();
+        QImage field(rect.size(), QImage::Format_RGB32);
+        for (int y = 0; y < field.height(); ++y) {
+            auto *line = reinterpret_cast<QRgb *>(field.scanLine(y));
+            for (int x = 0; x < field.width(); ++x) {
+                line[x] = QColor::fromHsv(359 * x / qMax(1, field.width() - 1), 255 - 255 * y / qMax(1, field.height() - 1), 255).rgb();
+            }
+        }
+        painter->drawImage(rect.topLeft(), field);
+    }
+};
+
+class KPaintBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void benchmarkRuler_data()
+    {
+        QTest::addColumn<int>("length");
+        QTest::addColumn<int>("metricStyle");
+
+        const std::pair<const char *, KRuler::MetricStyle> styles[] = {
+            {"pixel", KRuler::Pixel},
+            {"inch", KRuler::Inch},
+            {"millimetres", KRuler::Millimetres},
+        };
+        for (int length : {200, 2000}) {
+            for (const auto &[name, style] : styles) {
+                QTest::newRow((QByteArray(name) + '-' + QByteArray::number(length)).constData()) << length << int(style);
+            }
+        }
+    }
+
+    void benchmarkRuler()
+    {
+        QFETCH(int, length);
+        QFETCH(int, metricStyle);
+
+        KRuler ruler(Qt::Horizontal);
+        ruler.setRulerMetricStyle(KRuler::MetricStyle(metricStyle));
+        ruler.setRange(0, length);
+        ruler.setValue(length / 2);
+        ruler.resize(length, ruler.height());
+        QImage image = targetImage(ruler.size(), ruler.devicePixelRatioF());
+
+        // Scrolling, as when following the view
+        int offset = 0;
+        QBENCHMARK {
+            ruler.setOffset(offset++ % 100);
+            ruler.render(&image);
+        }
+    }
+
+    void benchmarkGradientSelector_data()
+    {
+        QTest::addColumn<bool>("translucent");
+
+        for (bool translucent : {false, true}) {
+            QTest::newRow(translucent ? "translucent" : "opaque") << translucent;
+        }
+    }
+
+    void benchmarkGradientSelector()
+    {
+        QFETCH(bool, translucent);
+
+        KGradientSelector selector(Qt::Horizontal);
+        selector.setColors(Qt::red, translucent ? QColor(0, 0, 255, 0) : QColor(Qt::blue));
+        selector.setText(QStringLiteral("Red"), QStringLiteral("Blue"));
+        selector.resize(300, 30);
+        QImage image = targetImage(selector.size(), selector.devicePixelRatioF());
+
+        // Dragging the arrow
+        int value = 0;
+        QBENCHMARK {
+            selector.setValue(value++ % 100);
+            selector.render(&image);
+        }
+    }
+
+    void benchmarkXYSelector_data()
+    {
+        QTest::addColumn<bool>("contentsCached");
+
+        for (bool cached : {false, true}) {
+            QTest::newRow(cached ? "cached" : "uncached") << cached;
+        }
+    }
+
+    void benchmarkXYSelector()
+    {
+        QFETCH(bool, contentsCached);
+
+        ColorFieldSelector selector;
+        selector.setContentsCached(contentsCached);
+        selector.setRange(0, 0, 100, 100);
+        selector.resize(256, 256);
+        QImage image = targetImage(selector.size(), selector.devicePixelRatioF());
+
+        // Dragging the marker
+        int value = 0;
+        QBENCHMARK {
+            selector.setValues(value % 100, (value * 7) % 100);
+            ++value;
+            selector.render(&image);
+        }
+    }
+
+    void benchmarkLed_data()
+    {
+        QTest::addColumn<int>("look");
+
+        const std::pair<const char *, KLed::Look> looks[] = {
+            {"flat", KLed::Flat},
+            {"raised", KLed::Raised},
+            {"sunken", KLed::Sunken},
+        };
+        for (const auto &[name, look] : looks) {
+            QTest::newRow(name) << int(look);
+        }
+    }
+
+    void benchmarkLed()
+    {
+        QFETCH(int, look);
+
+        KLed led(Qt::red, KLed::On, KLed::Look(look), KLed::Circular);
+        led.resize(32, 32);
+        QImage image = targetImage(led.size(), led.devicePixelRatioF());
+
+        // Blinking
+        QBENCHMARK {
+            led.toggle();
+            led.render(&image);
+        }
+    }
+
+    void benchmarkRatingPainter_data()
+    {
+        QTest::addColumn<bool>("hover");
+
+        for (bool hover : {false, true}) {
+            QTest::newRow(hover ? "hover" : "plain") << hover;
+        }
+    }
+
+    void benchmarkRatingPainter()
+    {
+        QFETCH(bool, hover);
+
+        KRatingPainter ratingPainter;
+        QImage image = targetImage(QSize(120, 24), qGuiApp->devicePixelRatio());
+
+        QBENCHMARK {
+            QPainter painter(&image);
+            ratingPainter.paint(&painter, QRect(QPoint(0, 0), QSize(120, 24)), 7, hover ? 4 : -1);
+        }
+    }
+
+    void benchmarkCapacityBar_data()
+    {
+        QTest::addColumn<int>("drawTextMode");
+
+        const std::pair<const char *, KCapacityBar::DrawTextMode> modes[] = {
+            {"inline", KCapacityBar::DrawTextInline},
+            {"outline", KCapacityBar::DrawTextOutline},
+        };
+        for (const auto &[name, mode] : modes) {
+            QTest::newRow(name) << int(mode);
+        }
+    }
+
+    void benchmarkCapacityBar()
+    {
+        QFETCH(int, drawTextMode);
+
+        KCapacityBar capacityBar(KCapacityBar::DrawTextMode(drawTextMode));
+        capacityBar.setText(QStringLiteral("60 GiB of 100 GiB used"));
+        capacityBar.resize(300, capacityBar.sizeHint().height());
+        QImage image = targetImage(capacityBar.size(), capacityBar.devicePixelRatioF());
+
+        int value = 0;
+        QBENCHMARK {
+            capacityBar.setValue(value++ % 100);
+            capacityBar.render(&image);
+        }
+    }
+};
+
+QTEST_MAIN(KPaintBenchmark)
+
+#include "kpaintbenchmark.moc"
@@ -0,0 +1,90 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <KRatingPainter>
+
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <QTest>
+
+static QPixmap starPixmap()
+{
+    QPixmap pixmap(32, 32);
+    pixmap.fill(Qt::transparent);
+    QPainter painter(&pixmap);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(255, 200, 0));
+    painter.drawEllipse(pixmap.rect());
+    return pixmap;
+}
+
+static QImage paintRating(const KRatingPainter &ratingPainter, int rating, int hoverRating = -1)
+{
+    QImage image(200, 20, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+    QPainter painter(&image);
+    ratingPainter.paint(&painter, image.rect(), rating, hoverRating);
+    return image;
+}
+
+class KRatingPainterTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testRepeatedPaint()
+    {
+        KRatingPainter ratingPainter;
+        ratingPainter.setCustomPixmap(starPixmap());
+
+        // The cached stars must give the same result as the first paint
+        const QImage first = paintRating(ratingPainter, 5, 7);
+        QCOMPARE(paintRating(ratingPainter, 5, 7), first);
+
+        // Another painter using the same pixmap shares the stars
+        KRatingPainter otherPainter;
+        otherPainter.setCustomPixmap(ratingPainter.customPixmap());
+        QCOMPARE(paintRating(otherPainter, 5, 7), first);
+    }
+
+    void testStates()
+    {
+        KRatingPainter ratingPainter;
+        ratingPainter.setCustomPixmap(starPixmap());
+
+        const QImage rated = paintRating(ratingPainter, 10);
+        const QImage unrated = paintRating(ratingPainter, 0);
+        const QImage hovered = paintRating(ratingPainter, 0, 10);
+        QVERIFY(rated != unrated);
+        QVERIFY(hovered != unrated);
+        QVERIFY(hovered != rated);
+
+        // Disabled painters must not reuse the stars of enabled ones
+        ratingPainter.setEnabled(false);
+        QVERIFY(paintRating(ratingPainter, 10) != rated);
+    }
+
+    void benchmarkPaint()
+    {
+        KRatingPainter ratingPainter;
+        ratingPainter.setCustomPixmap(starPixmap());
+
+        // Like an item view showing a rating column
+        QImage image(100, 20, QImage::Format_ARGB32_Premultiplied);
+        QPainter painter(&image);
+        QBENCHMARK {
+            for (int row = 0; row < 10000; ++row) {
+                ratingPainter.paint(&painter, image.rect(), row % 11, row % 7 == 0 ? 8 : -1);
+            }
+        }
+    }
+};
+
+QTEST_MAIN(KRatingPainterTest)
+
+#include "kratingpaintertest.moc"
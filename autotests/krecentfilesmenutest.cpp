@@ -0,0 +1,309 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <KRecentFilesMenu>
+
+#include <QFile>
+#include <QLineEdit>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QTest>
+#include <QWidgetAction>
+
+#include <memory>
+
+static QUrl fileUrl(const QString &name)
+{
+    return QUrl::fromLocalFile(QStringLiteral("/tmp/krecentfilesmenutest/") + name);
+}
+
+static QString recentFilesFileName()
+{
+    return QStringLiteral("%1/%2_recentfiles").arg(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation), QCoreApplication::applicationName());
+}
+
+// The URLs as stored in the file
+static QList<QUrl> storedUrls(const QString &group = QStringLiteral("RecentFiles"))
+{
+    QList<QUrl> urls;
+    QSettings settings(recentFilesFileName(), QSettings::IniFormat);
+    settings.beginGroup(group);
+    const int size = settings.beginReadArray(QStringLiteral("files"));
+    for (int i = 0; i < size; ++i) {
+        settings.setArrayIndex(i);
+        urls.append(settings.value(QStringLiteral("url")).toUrl());
+    }
+    settings.endArray();
+    settings.endGroup();
+    return urls;
+}
+
+// The actions of the files listed directly in the menu
+static QList<QAction *> entryActions(const QMenu *menu)
+{
+    QList<QAction *> subMenuActions;
+    const auto subMenus = menu->findChildren<QMenu *>(Qt::FindDirectChildrenOnly);
+    for (const QMenu *subMenu : subMenus) {
+        subMenuActions.append(subMenu->menuAction());
+    }
+
+    QList<QAction *> entries;
+    const auto actions = menu->actions();
+    for (QAction *action : actions) {
+        if (action->isSeparator()) {
+            break;
+        }
+        // Skip the filter, the submenus and "No Entries"
+        if (qobject_cast<QWidgetAction *>(action) || subMenuActions.contains(action) || !action->isEnabled()) {
+            continue;
+        }
+        entries.append(action);
+    }
+    return entries;
+}
+
+static QStringList names(const char *spaceSeparated)
+{
+    return QString::fromLatin1(spaceSeparated).split(QLatin1Char(' '), Qt::SkipEmptyParts);
+}
+
+// The submenu with the next page of files
+static QMenu *nextPageMenu(const QMenu *menu)
+{
+    return menu->findChild<QMenu *>(QString(), Qt::FindDirectChildrenOnly);
+}
+
+static QStringList entryTexts(const QMenu *menu)
+{
+    QStringList texts;
+    const auto actions = entryActions(menu);
+    for (const QAction *action : actions) {
+        texts.append(action->text());
+    }
+    return texts;
+}
+
+class KRecentFilesMenuTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QStandardPaths::setTestModeEnabled(true);
+    }
+
+    void init()
+    {
+        QFile::remove(recentFilesFileName());
+    }
+
+    void testDelayedWrite()
+    {
+        KRecentFilesMenu menu;
+        menu.addUrl(fileUrl(QStringLiteral("a.txt")));
+        menu.addUrl(fileUrl(QStringLiteral("b.txt")));
+        menu.addUrl(fileUrl(QStringLiteral("c.txt")));
+
+        // A burst of changes is written once settled
+        const QList<QUrl> expected({fileUrl(QStringLiteral("c.txt")), fileUrl(QStringLiteral("b.txt")), fileUrl(QStringLiteral("a.txt"))});
+        QCOMPARE(menu.recentFiles(), expected);
+        QVERIFY(storedUrls().isEmpty());
+        QTRY_COMPARE(storedUrls(), expected);
+
+        menu.removeUrl(fileUrl(QStringLiteral("b.txt")));
+        QTRY_COMPARE(storedUrls(), QList<QUrl>({fileUrl(QStringLiteral("c.txt")), fileUrl(QStringLiteral("a.txt"))}));
+
+        menu.clearRecentFiles();
+        QTRY_VERIFY(storedUrls().isEmpty());
+    }
+
+    void testWriteOnDestruction()
+    {
+        auto menu = std::make_unique<KRecentFilesMenu>();
+        menu->addUrl(fileUrl(QStringLiteral("a.txt")));
+        menu->addUrl(fileUrl(QStringLiteral("b.txt")));
+        menu->addUrl(fileUrl(QStringLiteral("c.txt")));
+        menu->removeUrl(fileUrl(QStringLiteral("b.txt")));
+        const QList<QUrl> urls = menu->recentFiles();
+        QCOMPARE(urls, QList<QUrl>({fileUrl(QStringLiteral("c.txt")), fileUrl(QStringLiteral("a.txt"))}));
+
+        // Pending changes are flushed right away
+        menu.reset();
+        QCOMPARE(storedUrls(), urls);
+
+        // And read back by the next menu
+        KRecentFilesMenu otherMenu;
+        QCOMPARE(otherMenu.recentFiles(), urls);
+
+        otherMenu.clearRecentFiles();
+        QCOMPARE(otherMenu.recentFiles(), QList<QUrl>());
+    }
+
+    void testSetGroup()
+    {
+        KRecentFilesMenu menu;
+        menu.addUrl(fileUrl(QStringLiteral("a.txt")));
+
+        // Pending changes are written to the old group first
+        menu.setGroup(QStringLiteral("Other"));
+        QCOMPARE(menu.group(), QStringLiteral("Other"));
+        QCOMPARE(storedUrls(), QList<QUrl>({fileUrl(QStringLiteral("a.txt"))}));
+        QVERIFY(menu.recentFiles().isEmpty());
+
+        menu.addUrl(fileUrl(QStringLiteral("b.txt")));
+        menu.setGroup(QStringLiteral("RecentFiles"));
+        QCOMPARE(storedUrls(QStringLiteral("Other")), QList<QUrl>({fileUrl(QStringLiteral("b.txt"))}));
+        QCOMPARE(menu.recentFiles(), storedUrls());
+    }
+
+    void testIncrementalUpdates()
+    {
+        KRecentFilesMenu menu;
+        QCOMPARE(entryTexts(&menu), QStringList());
+
+        menu.addUrl(fileUrl(QStringLiteral("a.txt")));
+        menu.addUrl(fileUrl(QStringLiteral("b.txt")));
+        menu.addUrl(fileUrl(QStringLiteral("c.txt")));
+        QCOMPARE(entryTexts(&menu), QStringList({QStringLiteral("c.txt"), QStringLiteral("b.txt"), QStringLiteral("a.txt")}));
+        const QList<QAction *> actions = entryActions(&menu);
+
+        // The actions are kept, only moved or removed
+        menu.addUrl(fileUrl(QStringLiteral("a.txt")));
+        QCOMPARE(entryActions(&menu), QList<QAction *>({actions[2], actions[0], actions[1]}));
+        menu.removeUrl(fileUrl(QStringLiteral("c.txt")));
+        QCOMPARE(entryActions(&menu), QList<QAction *>({actions[2], actions[1]}));
+        QCOMPARE(entryTexts(&menu), QStringList({QStringLiteral("a.txt"), QStringLiteral("b.txt")}));
+        QCOMPARE(menu.recentFiles(), QList<QUrl>({fileUrl(QStringLiteral("a.txt")), fileUrl(QStringLiteral("b.txt"))}));
+
+        // Oldest ones are dropped
+        menu.setMaximumItems(3);
+        menu.addUrl(fileUrl(QStringLiteral("d.txt")));
+        menu.addUrl(fileUrl(QStringLiteral("e.txt")));
+        QCOMPARE(entryTexts(&menu), QStringList({QStringLiteral("e.txt"), QStringLiteral("d.txt"), QStringLiteral("a.txt")}));
+
+        menu.clearRecentFiles();
+        QCOMPARE(entryTexts(&menu), QStringList());
+    }
+
+    void testLazyTitles()
+    {
+        KRecentFilesMenu menu;
+        const QUrl url = fileUrl(QStringLiteral("a.txt"));
+        const QString title = QStringLiteral("a.txt [") + url.toDisplayString(QUrl::PreferLocalFile) + QLatin1Char(']');
+        menu.addUrl(url);
+
+        // Only the name until shown
+        QCOMPARE(entryTexts(&menu), QStringList({QStringLiteral("a.txt")}));
+        Q_EMIT menu.aboutToShow();
+        QCOMPARE(entryTexts(&menu), QStringList({title}));
+
+        // A new name needs a new title
+        menu.addUrl(url, QStringLiteral("Renamed"));
+        QCOMPARE(entryTexts(&menu), QStringList({QStringLiteral("Renamed")}));
+        Q_EMIT menu.aboutToShow();
+        QCOMPARE(entryTexts(&menu), QStringList({QStringLiteral("Renamed [") + url.toDisplayString(QUrl::PreferLocalFile) + QLatin1Char(']')}));
+    }
+
+    void testPageSize()
+    {
+        KRecentFilesMenu menu;
+        QCOMPARE(menu.pageSize(), 0);
+        for (const QString &name : names("1 2 3 4 5 6 7")) {
+            menu.addUrl(fileUrl(name));
+        }
+
+        // All in the menu itself
+        QCOMPARE(entryTexts(&menu), names("7 6 5 4 3 2 1"));
+        QMenu *moreMenu = nextPageMenu(&menu);
+        QVERIFY(moreMenu);
+        QVERIFY(!moreMenu->menuAction()->isVisible());
+
+        // Pages of three
+        menu.setPageSize(3);
+        QCOMPARE(menu.pageSize(), 3);
+        QCOMPARE(entryTexts(&menu), names("7 6 5"));
+        QVERIFY(moreMenu->menuAction()->isVisible());
+
+        // Filled once shown
+        QVERIFY(moreMenu->actions().isEmpty());
+        Q_EMIT moreMenu->aboutToShow();
+        QCOMPARE(entryTexts(moreMenu), names("4 3 2"));
+        QMenu *lastPageMenu = nextPageMenu(moreMenu);
+        QVERIFY(lastPageMenu);
+        Q_EMIT lastPageMenu->aboutToShow();
+        QCOMPARE(entryTexts(lastPageMenu), names("1"));
+        QVERIFY(!nextPageMenu(lastPageMenu));
+
+        // Removing from the first page moves up the first of the next one
+        menu.removeUrl(fileUrl(QStringLiteral("6")));
+        QCOMPARE(entryTexts(&menu), names("7 5 4"));
+
+        // Adding pushes the last one to the next page
+        menu.addUrl(fileUrl(QStringLiteral("8")));
+        QCOMPARE(entryTexts(&menu), names("8 7 5"));
+        menu.addUrl(fileUrl(QStringLiteral("2")));
+        QCOMPARE(entryTexts(&menu), names("2 8 7"));
+        Q_EMIT moreMenu->aboutToShow();
+        QCOMPARE(entryTexts(moreMenu), names("5 4 3"));
+
+        // Back to a single page
+        menu.setPageSize(0);
+        QCOMPARE(entryTexts(&menu), names("2 8 7 5 4 3 1"));
+        QVERIFY(!moreMenu->menuAction()->isVisible());
+    }
+
+    void testFilter()
+    {
+        KRecentFilesMenu menu;
+        QVERIFY(!menu.isFilterEnabled());
+        for (const QString &name : names("apple banana Apricot cherry avocado")) {
+            menu.addUrl(fileUrl(name));
+        }
+
+        menu.setFilterEnabled(true);
+        QVERIFY(menu.isFilterEnabled());
+        auto *filterAction = qobject_cast<QWidgetAction *>(menu.actions().value(0));
+        QVERIFY(filterAction);
+        auto *lineEdit = qobject_cast<QLineEdit *>(filterAction->defaultWidget());
+        QVERIFY(lineEdit);
+
+        const QStringList all = names("avocado cherry Apricot banana apple");
+        QCOMPARE(entryTexts(&menu), all);
+
+        // Matching the start of the name, case insensitive, most recent first
+        lineEdit->setText(QStringLiteral("a"));
+        QCOMPARE(entryTexts(&menu), names("avocado Apricot apple"));
+        lineEdit->setText(QStringLiteral("AP"));
+        QCOMPARE(entryTexts(&menu), names("Apricot apple"));
+        lineEdit->setText(QStringLiteral("x"));
+        QCOMPARE(entryTexts(&menu), QStringList());
+
+        // Added and removed files are filtered as well
+        lineEdit->setText(QStringLiteral("ap"));
+        menu.addUrl(fileUrl(QStringLiteral("apricot2")));
+        menu.addUrl(fileUrl(QStringLiteral("blueberry")));
+        QCOMPARE(entryTexts(&menu), names("apricot2 Apricot apple"));
+        menu.removeUrl(fileUrl(QStringLiteral("Apricot")));
+        QCOMPARE(entryTexts(&menu), names("apricot2 apple"));
+
+        // Limited to the page size
+        menu.setPageSize(1);
+        QCOMPARE(entryTexts(&menu), names("apricot2"));
+
+        lineEdit->clear();
+        QCOMPARE(entryTexts(&menu), names("blueberry"));
+
+        menu.setFilterEnabled(false);
+        QVERIFY(!menu.isFilterEnabled());
+        QVERIFY(!qobject_cast<QWidgetAction *>(menu.actions().value(0)));
+    }
+};
+
+QTEST_MAIN(KRecentFilesMenuTest)
+
+#include "krecentfilesmenutest.moc"
@@ -0,0 +1,187 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <KSqueezedTextDelegate>
+
+#include <QApplication>
+#include <QImage>
+#include <QPainter>
+#include <QStandardItemModel>
+#include <QStyle>
+#include <QTest>
+
+class PlainDelegate : public QStyledItemDelegate
+{
+public:
+    using QStyledItemDelegate::initStyleOption;
+};
+
+class KSqueezedTextDelegateTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    QStyleOptionViewItem option(int width, const QFont &font) const
+    {
+        QStyleOptionViewItem opt;
+        opt.rect = QRect(0, 0, width, 24);
+        opt.font = font;
+        opt.fontMetrics = QFontMetrics(font);
+        opt.palette = QApplication::palette();
+        opt.state = QStyle::State_Enabled;
+        return opt;
+    }
+
+    QImage paintDelegate(const KSqueezedTextDelegate &delegate, const QStyleOptionViewItem &option)
+    {
+        QImage image(option.rect.size(), QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::white);
+        QPainter painter(&image);
+        delegate.paint(&painter, option, m_model.index(0, 0));
+        return image;
+    }
+
+    // What the delegate should paint, text elided as by the width of the text rect of the style
+    QImage paintExpected(const QStyleOptionViewItem &option, Qt::TextElideMode mode, QString *elidedText)
+    {
+        QStyleOptionViewItem opt = option;
+        PlainDelegate plainDelegate;
+        plainDelegate.initStyleOption(&opt, m_model.index(0, 0));
+
+        QStyle *style = QApplication::style();
+        const int textMargin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, nullptr) + 1;
+        const int width = style->subElementRect(QStyle::SE_ItemViewItemText, &opt, nullptr).width() - 2 * textMargin;
+        *elidedText = QFontMetrics(opt.font).elidedText(opt.text, mode, width);
+        opt.text = *elidedText;
+        opt.textElideMode = Qt::ElideNone;
+
+        QImage image(opt.rect.size(), QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::white);
+        QPainter painter(&image);
+        style->drawControl(QStyle::CE_ItemViewItem, &opt, &painter, nullptr);
+        return image;
+    }
+
+    void setText(const QString &text)
+    {
+        m_model.clear();
+        m_model.appendRow(new QStandardItem(text));
+    }
+
+    QStandardItemModel m_model;
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QApplication::setStyle(QStringLiteral("Fusion"));
+    }
+
+    void testElideMode_data()
+    {
+        QTest::addColumn<Qt::TextElideMode>("mode");
+
+        QTest::newRow("left") << Qt::ElideLeft;
+        QTest::newRow("right") << Qt::ElideRight;
+        QTest::newRow("middle") << Qt::ElideMiddle;
+    }
+
+    void testElideMode()
+    {
+        QFETCH(Qt::TextElideMode, mode);
+
+        const QString text = QStringLiteral("The beginning of a long text, which is elided somewhere, and its end");
+        setText(text);
+
+        KSqueezedTextDelegate delegate;
+        delegate.setTextElideMode(mode);
+        QCOMPARE(delegate.textElideMode(), mode);
+
+        const QStyleOptionViewItem opt = option(150, QApplication::font());
+        QString elidedText;
+        const QImage expected = paintExpected(opt, mode, &elidedText);
+        QVERIFY(elidedText != text);
+        QVERIFY(elidedText.contains(QChar(0x2026)));
+        QCOMPARE(paintDelegate(delegate, opt), expected);
+    }
+
+    void testNotElided()
+    {
+        setText(QStringLiteral("Short"));
+
+        KSqueezedTextDelegate delegate;
+        const QStyleOptionViewItem opt = option(300, QApplication::font());
+        QString elidedText;
+        const QImage expected = paintExpected(opt, Qt::ElideMiddle, &elidedText);
+        QCOMPARE(elidedText, QStringLiteral("Short"));
+        QCOMPARE(paintDelegate(delegate, opt), expected);
+
+        // Left to the style without eliding
+        delegate.setTextElideMode(Qt::ElideNone);
+        QStyleOptionViewItem narrowOpt = option(20, QApplication::font());
+        PlainDelegate plainDelegate;
+        QImage plain(narrowOpt.rect.size(), QImage::Format_ARGB32_Premultiplied);
+        plain.fill(Qt::white);
+        {
+            QPainter painter(&plain);
+            plainDelegate.paint(&painter, narrowOpt, m_model.index(0, 0));
+        }
+        QCOMPARE(paintDelegate(delegate, narrowOpt), plain);
+    }
+
+    // The elided texts are cached by text, font, width and elide mode,
+    // so any change of them needs to give the elision for the new ones
+    void testCache()
+    {
+        setText(QStringLiteral("A text only used to check the cache of the elided texts"));
+
+        KSqueezedTextDelegate delegate;
+        QFont font = QApplication::font();
+        const QStyleOptionViewItem opt = option(120, font);
+        QString elidedText;
+        const QImage expected = paintExpected(opt, Qt::ElideMiddle, &elidedText);
+
+        // Repeated paints, also from other delegates
+        QCOMPARE(paintDelegate(delegate, opt), expected);
+        QCOMPARE(paintDelegate(delegate, opt), expected);
+        KSqueezedTextDelegate otherDelegate;
+        QCOMPARE(paintDelegate(otherDelegate, opt), expected);
+
+        // Another width
+        const QStyleOptionViewItem narrowOpt = option(100, font);
+        QString narrowText;
+        QCOMPARE(paintDelegate(delegate, narrowOpt), paintExpected(narrowOpt, Qt::ElideMiddle, &narrowText));
+        QVERIFY(narrowText != elidedText);
+
+        // Another font
+        font.setBold(!font.bold());
+        const QStyleOptionViewItem boldOpt = option(120, font);
+        QString boldText;
+        QCOMPARE(paintDelegate(delegate, boldOpt), paintExpected(boldOpt, Qt::ElideMiddle, &boldText));
+        QVERIFY(boldText != elidedText);
+
+        // Another elide mode
+        delegate.setTextElideMode(Qt::ElideLeft);
+        QString leftText;
+        QCOMPARE(paintDelegate(delegate, opt), paintExpected(opt, Qt::ElideLeft, &leftText));
+        QVERIFY(leftText != elidedText);
+
+        // Another text
+        setText(QStringLiteral("Another text, long enough to be elided by the delegate as well"));
+        QString otherText;
+        QCOMPARE(paintDelegate(delegate, opt), paintExpected(opt, Qt::ElideLeft, &otherText));
+        QVERIFY(otherText != leftText);
+
+        // And back, the same as at first
+        delegate.setTextElideMode(Qt::ElideMiddle);
+        setText(QStringLiteral("A text only used to check the cache of the elided texts"));
+        QCOMPARE(paintDelegate(delegate, opt), expected);
+    }
+};
+
+QTEST_MAIN(KSqueezedTextDelegateTest)
+
+#include "ksqueezedtextdelegatetest.moc"
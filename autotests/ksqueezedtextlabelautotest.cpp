@@ -226,6 +226,63 @@ void KSqueezedTextLabelAutotest::testChrome()
     QCOMPARE(label->width(), oldWidth + widthDifference);
 }
 
+void KSqueezedTextLabelAutotest::testResizeCache()
+{
+    const QString text = QStringLiteral("/home/user/Documents/Projects/some/deeply/nested/folder/file.txt");
+    const auto label = createLabel(text);
+    const int fullWidth = label->width();
+    const QFontMetrics fm(label->fontMetrics());
+
+    // Shrink, grow again and shrink once more, the results must not depend on the history
+    QList<int> widths;
+    for (int width = fullWidth; width > fullWidth / 4; width -= 7) {
+        widths << width;
+    }
+    for (int width = fullWidth / 4; width < fullWidth; width += 5) {
+        widths << width;
+    }
+    for (int width = fullWidth; width > fullWidth / 2; width -= 3) {
+        widths << width;
+    }
+
+    for (const int width : std::as_const(widths)) {
+        label->resize(width, label->height());
+        const int labelWidth = label->contentsRect().width();
+        if (fm.boundingRect(text).width() > labelWidth) {
+            QCOMPARE(label->text(), fm.elidedText(text, Qt::ElideMiddle, labelWidth));
+            QCOMPARE(label->toolTip(), text);
+        } else {
+            QCOMPARE(label->text(), text);
+            QVERIFY(label->toolTip().isEmpty());
+        }
+    }
+
+    // A new elide mode must not reuse the elided texts of the old one
+    label->resize(fullWidth / 2, label->height());
+    label->setTextElideMode(Qt::ElideRight);
+    QCOMPARE(label->text(), fm.elidedText(text, Qt::ElideRight, label->contentsRect().width()));
+}
+
+void KSqueezedTextLabelAutotest::benchmarkResize()
+{
+    QStringList lines;
+    for (int i = 0; i < 5; ++i) {
+        lines << QStringLiteral("/home/user/Documents/Projects/some/deeply/nested/folder/file%1.txt").arg(i);
+    }
+    const auto label = createLabel(lines.join(QLatin1Char('\n')));
+    const int fullWidth = label->width();
+
+    // Like dragging a splitter back and forth
+    QBENCHMARK {
+        for (int width = fullWidth; width > fullWidth / 3; width -= 2) {
+            label->resize(width, label->height());
+        }
+        for (int width = fullWidth / 3; width < fullWidth; width += 2) {
+            label->resize(width, label->height());
+        }
+    }
+}
+
 QTEST_MAIN(KSqueezedTextLabelAutotest)
 
 // TODO
@@ -26,6 +26,8 @@ private Q_SLOTS:
     void testClearing();
     void testChrome_data();
     void testChrome();
+    void testResizeCache();
+    void benchmarkResize();
 };
 
 #endif
@@ -155,6 +155,55 @@ void KTimeComboBoxTest::testTimeList()
     delete m_combo;
 }
 
+void KTimeComboBoxTest::testForceTime()
+{
+    m_combo = new KTimeComboBox();
+    m_combo->setOptions(m_combo->options() | KTimeComboBox::ForceTime);
+
+    // Forced to the nearest time of the interval list
+    m_combo->setTime(QTime(10, 7, 0));
+    QCOMPARE(m_combo->time(), QTime(10, 0, 0));
+    m_combo->setTime(QTime(10, 8, 0));
+    QCOMPARE(m_combo->time(), QTime(10, 15, 0));
+    m_combo->setTime(QTime(23, 59, 0));
+    QCOMPARE(m_combo->time(), QTime(23, 59, 0));
+    QCOMPARE(m_combo->currentIndex(), m_combo->count() - 1);
+
+    // Every minute of the day
+    m_combo->setTimeListInterval(1);
+    QCOMPARE(m_combo->count(), 1441);
+    QCOMPARE(m_combo->itemData(600).toTime(), QTime(10, 0, 0));
+    QCOMPARE(m_combo->itemText(600), QLocale().toString(QTime(10, 0, 0), QLocale::ShortFormat));
+    m_combo->setTime(QTime(10, 0, 40));
+    QCOMPARE(m_combo->time(), QTime(10, 1, 0));
+    QCOMPARE(m_combo->currentIndex(), 601);
+
+    // Forced to the nearest time of a given list
+    m_combo->setTimeList({QTime(8, 0, 0), QTime(9, 30, 0), QTime(17, 0, 0)});
+    m_combo->setTime(QTime(9, 0, 0));
+    QCOMPARE(m_combo->time(), QTime(9, 30, 0));
+    m_combo->setTime(QTime(8, 30, 0));
+    QCOMPARE(m_combo->time(), QTime(8, 0, 0));
+    m_combo->setTime(QTime(18, 0, 0));
+    QCOMPARE(m_combo->time(), QTime(17, 0, 0));
+    QCOMPARE(m_combo->currentIndex(), 2);
+    delete m_combo;
+}
+
+void KTimeComboBoxTest::testSizeHint()
+{
+    m_combo = new KTimeComboBox();
+    const QSize sizeHint = m_combo->sizeHint();
+    const int textWidth = m_combo->fontMetrics().boundingRect(QLocale().toString(QTime(23, 59, 59, 999), QLocale::ShortFormat)).width();
+    QVERIFY(sizeHint.width() > textWidth);
+    QCOMPARE(m_combo->minimumSizeHint(), sizeHint);
+
+    // Not depending on the number of times in the list
+    m_combo->setTimeListInterval(1);
+    QCOMPARE(m_combo->sizeHint(), sizeHint);
+    delete m_combo;
+}
+
 void KTimeComboBoxTest::testOptions()
 {
     m_combo = new KTimeComboBox();
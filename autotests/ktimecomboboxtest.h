@@ -24,6 +24,8 @@ private Q_SLOTS:
     void testTimeRange();
     void testTimeListInterval();
     void testTimeList();
+    void testForceTime();
+    void testSizeHint();
     void testOptions();
     void testDisplayFormat();
     void testMask();
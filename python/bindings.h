@@ -38,6 +38,7 @@
 #include <KGuiItem>
 #include <KJobWidgets>
 #include <KLed>
+#include <KLedMatrix>
 #include <KLineEditEventHandler>
 #include <KLineEditUrlDropEventFilter>
 #include <KMessageBox>
@@ -74,6 +75,7 @@
 #include <KSelector>
 #include <KSeparator>
 #include <KSplitterCollapserButton>
+#include <KSqueezedTextDelegate>
 #include <KSqueezedTextLabel>
 #include <KStandardGuiItem>
 #include <KStyleExtensions>
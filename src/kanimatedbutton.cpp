@@ -9,12 +9,68 @@
 
 #include <kanimatedbutton.h>
 
+#include <QCache>
+#include <QGlobalStatic>
 #include <QImageReader>
 #include <QMovie>
 #include <QPainter>
 #include <QPixmap>
+#include <QPixmapCache>
 #include <QTimer>
 
+#include <algorithm>
+
+namespace
+{
+struct FrameKey {
+    QString path;
+    int frame;
+    QSize size;
+    qreal devicePixelRatio;
+
+    bool operator==(const FrameKey &other) const
+    {
+        return frame == other.frame && size == other.size && devicePixelRatio == other.devicePixelRatio && path == other.path;
+    }
+};
+
+size_t qHash(const FrameKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.path, key.frame, key.size.width(), key.size.height(), key.devicePixelRatio);
+}
+}
+
+// Frames of the animations, shared by all buttons, so buttons with the same
+// animation use the same pixmaps, which also lets the icon code cache them
+// only once in QPixmapCache. Bounded in size, dropping the least recently
+// used frames first, as animations loaded with QMovie can be long.
+class KAnimatedButtonFrameCache
+{
+public:
+    KAnimatedButtonFrameCache()
+    {
+        // in KiB
+        m_frames.setMaxCost(8 * 1024);
+    }
+
+    QPixmap frame(const FrameKey &key)
+    {
+        const QPixmap *frame = m_frames.object(key);
+        return frame ? *frame : QPixmap();
+    }
+
+    void insert(FrameKey &&key, const QPixmap &frame)
+    {
+        const qsizetype cost = std::max<qsizetype>(1, qsizetype(frame.width()) * frame.height() * frame.depth() / 8 / 1024);
+        m_frames.insert(std::move(key), new QPixmap(frame), cost);
+    }
+
+private:
+    QCache<FrameKey, QPixmap> m_frames;
+};
+
+Q_GLOBAL_STATIC(KAnimatedButtonFrameCache, s_frameCache)
+
 class KAnimatedButtonPrivate
 {
 public:
@@ -37,9 +93,6 @@ public:
     QPixmap pixmap;
     QTimer timer;
     QString icon_path;
-    QList<QPixmap *> framesCache; // We keep copies of each frame so that
-    // the icon code can properly cache them in QPixmapCache,
-    // and not fill it up with dead copies
 };
 
 KAnimatedButton::KAnimatedButton(QWidget *parent)
@@ -54,7 +107,6 @@ KAnimatedButton::KAnimatedButton(QWidget *parent)
 KAnimatedButton::~KAnimatedButton()
 {
     d->timer.stop();
-    qDeleteAll(d->framesCache);
     delete d->movie;
 }
 
@@ -117,27 +169,35 @@ void KAnimatedButtonPrivate::updateCurrentIcon()
         return;
     }
 
-    QPixmap *frame = framesCache[current_frame];
-    if (!frame) {
-        const int icon_size = qMin(pixmap.width(), pixmap.height());
+    const int icon_size = qMin(pixmap.width(), pixmap.height());
+    FrameKey key{icon_path, current_frame, QSize(icon_size, icon_size), pixmap.devicePixelRatio()};
+    QPixmap frame = s_frameCache()->frame(key);
+    if (frame.isNull()) {
         const int row_size = pixmap.width() / icon_size;
         const int row = current_frame / row_size;
         const int column = current_frame % row_size;
-        frame = new QPixmap(icon_size, icon_size);
-        frame->fill(Qt::transparent);
-        QPainter p(frame);
+        frame = QPixmap(icon_size, icon_size);
+        frame.fill(Qt::transparent);
+        QPainter p(&frame);
         p.drawPixmap(QPoint(0, 0), pixmap, QRect(column * icon_size, row * icon_size, icon_size, icon_size));
         p.end();
-        framesCache[current_frame] = frame;
+        s_frameCache()->insert(std::move(key), frame);
     }
 
-    q->setIcon(QIcon(*frame));
+    q->setIcon(QIcon(frame));
 }
 
 void KAnimatedButtonPrivate::movieFrameChanged(int number)
 {
-    Q_UNUSED(number);
-    q->setIcon(QIcon(movie->currentPixmap()));
+    const QPixmap currentPixmap = movie->currentPixmap();
+    FrameKey key{icon_path, number, currentPixmap.size(), currentPixmap.devicePixelRatio()};
+    // Prefer the frame already used by other buttons
+    QPixmap frame = s_frameCache()->frame(key);
+    if (frame.isNull()) {
+        frame = currentPixmap;
+        s_frameCache()->insert(std::move(key), frame);
+    }
+    q->setIcon(QIcon(frame));
 }
 
 void KAnimatedButtonPrivate::movieFinished()
@@ -156,7 +216,8 @@ void KAnimatedButtonPrivate::updateIcons()
     if (QMovie::supportedFormats().contains(reader.format())) {
         newMovie = new QMovie(icon_path);
         frames = 0;
-        newMovie->setCacheMode(QMovie::CacheAll);
+        // The frames are kept in the shared cache instead
+        newMovie->setCacheMode(QMovie::CacheNone);
         QObject::connect(newMovie, &QMovie::frameChanged, q, [this](int value) {
             movieFrameChanged(value);
         });
@@ -164,9 +225,15 @@ void KAnimatedButtonPrivate::updateIcons()
             movieFinished();
         });
     } else {
-        const QPixmap pix(icon_path);
-        if (pix.isNull()) {
-            return;
+        // Share the loaded file between all buttons using it
+        const QString cacheKey = QLatin1String("kanimatedbutton_") + icon_path;
+        QPixmap pix;
+        if (!QPixmapCache::find(cacheKey, &pix)) {
+            pix = QPixmap(icon_path);
+            if (pix.isNull()) {
+                return;
+            }
+            QPixmapCache::insert(cacheKey, pix);
         }
 
         const int icon_size = qMin(pix.width(), pix.height());
@@ -179,9 +246,6 @@ void KAnimatedButtonPrivate::updateIcons()
     }
 
     current_frame = 0;
-    qDeleteAll(framesCache);
-    framesCache.fill(nullptr);
-    framesCache.resize(frames);
     delete movie;
     movie = newMovie;
 
@@ -7,11 +7,146 @@
 #include "kbusyindicatorwidget.h"
 
 #include <QApplication>
+#include <QCache>
+#include <QElapsedTimer>
+#include <QGlobalStatic>
 #include <QIcon>
 #include <QPainter>
 #include <QResizeEvent>
 #include <QStyle>
-#include <QVariantAnimation>
+#include <QTimer>
+#include <QWindow>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Time for one full rotation, in ms
+static constexpr int s_rotationDuration = 2000;
+// Number of distinct rotation steps rendered for a full rotation
+static constexpr int s_frameCount = 60;
+
+namespace
+{
+struct FrameSetKey {
+    qint64 iconKey;
+    QString themeName;
+    QSize size;
+    qreal devicePixelRatio;
+
+    bool operator==(const FrameSetKey &other) const
+    {
+        return iconKey == other.iconKey && size == other.size && devicePixelRatio == other.devicePixelRatio && themeName == other.themeName;
+    }
+};
+
+size_t qHash(const FrameSetKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.iconKey, key.themeName, key.size.width(), key.size.height(), key.devicePixelRatio);
+}
+
+struct FrameSet {
+    // Null until first needed
+    QPixmap frames[s_frameCount];
+};
+}
+
+// Rotated renderings of the indicator icons, shared by all indicators,
+// so painting a frame is a plain blit instead of a smooth transformation.
+class KBusyIndicatorFrameCache
+{
+public:
+    KBusyIndicatorFrameCache()
+    {
+        // in KiB
+        m_frameSets.setMaxCost(16 * 1024);
+    }
+
+    QPixmap frame(const QIcon &icon, const QSize &size, qreal devicePixelRatio, int index);
+
+private:
+    QCache<FrameSetKey, FrameSet> m_frameSets;
+};
+
+QPixmap KBusyIndicatorFrameCache::frame(const QIcon &icon, const QSize &size, qreal devicePixelRatio, int index)
+{
+    // The theme is part of the key, as icons from the theme follow theme changes
+    FrameSetKey key{icon.cacheKey(), QIcon::themeName(), size, devicePixelRatio};
+    FrameSet *frameSet = m_frameSets.object(key);
+    if (!frameSet) {
+        frameSet = new FrameSet;
+        const QSize pixelSize = size * devicePixelRatio;
+        const int cost = std::max(1, s_frameCount * pixelSize.width() * pixelSize.height() * 4 / 1024);
+        if (!m_frameSets.insert(std::move(key), frameSet, cost)) {
+            // Too large to be cached, render it anyway
+            frameSet = nullptr;
+        }
+    }
+
+    QPixmap pixmap = frameSet ? frameSet->frames[index] : QPixmap();
+    if (!pixmap.isNull()) {
+        return pixmap;
+    }
+
+    pixmap = QPixmap(size * devicePixelRatio);
+    pixmap.setDevicePixelRatio(devicePixelRatio);
+    pixmap.fill(Qt::transparent);
+
+    QPainter painter(&pixmap);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+
+    // Rotate around the center and then reset back to origin for icon painting.
+    const QPointF center(size.width() / 2.0, size.height() / 2.0);
+    painter.translate(center);
+    painter.rotate(index * 360.0 / s_frameCount);
+    painter.translate(-center);
+
+    icon.paint(&painter, QRect(QPoint(0, 0), size));
+    painter.end();
+
+    if (frameSet) {
+        frameSet->frames[index] = pixmap;
+    }
+    return pixmap;
+}
+
+Q_GLOBAL_STATIC(KBusyIndicatorFrameCache, s_frameCache)
+
+class KBusyIndicatorWidgetPrivate;
+
+// Drives the animation of all running indicators, so they are updated in the same
+// frame and only one timer is active. Indicators which cannot be seen, because their
+// window is minimized or covered or they are scrolled out of view, are dropped until
+// they get painted again.
+class KBusyIndicatorClock
+{
+public:
+    KBusyIndicatorClock();
+
+    void add(KBusyIndicatorWidgetPrivate *indicator);
+    void remove(KBusyIndicatorWidgetPrivate *indicator);
+
+    qint64 elapsed() const
+    {
+        return m_clock.elapsed();
+    }
+
+    int maximumFrameRate() const
+    {
+        return m_maximumFrameRate;
+    }
+    void setMaximumFrameRate(int framesPerSecond);
+
+private:
+    void tick();
+
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    std::vector<KBusyIndicatorWidgetPrivate *> m_indicators;
+    int m_maximumFrameRate = 60;
+};
+
+Q_GLOBAL_STATIC(KBusyIndicatorClock, s_clock)
 
 class KBusyIndicatorWidgetPrivate
 {
@@ -19,23 +154,108 @@ public:
     KBusyIndicatorWidgetPrivate(KBusyIndicatorWidget *parent)
         : q(parent)
     {
-        animation.setLoopCount(-1);
-        animation.setDuration(2000);
-        animation.setStartValue(0);
-        animation.setEndValue(360);
-        QObject::connect(&animation, &QVariantAnimation::valueChanged, q, [this](QVariant value) {
-            rotation = value.toReal();
-            q->update(); // repaint new rotation
-        });
+    }
+
+    ~KBusyIndicatorWidgetPrivate()
+    {
+        if (registered && !s_clock.isDestroyed()) {
+            s_clock()->remove(this);
+        }
+    }
+
+    qreal rotation() const
+    {
+        if (!running) {
+            return stoppedRotation;
+        }
+        const qint64 elapsed = s_clock()->elapsed() - startTime;
+        return std::fmod(stoppedRotation + elapsed * 360.0 / s_rotationDuration, 360.0);
+    }
+
+    int frameIndex() const
+    {
+        return int(std::lround(rotation() * s_frameCount / 360.0)) % s_frameCount;
+    }
+
+    bool isExposed() const
+    {
+        const QWindow *window = q->window()->windowHandle();
+        return window && window->isExposed() && window->visibility() != QWindow::Minimized && !q->visibleRegion().isEmpty();
+    }
+
+    void updateRegistration()
+    {
+        const bool animated = running && q->isVisible();
+        if (animated && !registered) {
+            s_clock()->add(this);
+        } else if (!animated && registered) {
+            s_clock()->remove(this);
+        }
     }
 
     KBusyIndicatorWidget *const q;
-    QVariantAnimation animation;
     QIcon icon = QIcon::fromTheme(QStringLiteral("view-refresh"));
-    qreal rotation = 0;
-    QPointF paintCenter;
+    bool running = false;
+    // Whether updated by the clock
+    bool registered = false;
+    // Rotation when last stopped, the rotation starts from there when running
+    qreal stoppedRotation = 0;
+    // Clock time of the last start
+    qint64 startTime = 0;
+    // Frame shown by the last paint, -1 if none
+    int paintedFrame = -1;
 };
 
+KBusyIndicatorClock::KBusyIndicatorClock()
+{
+    m_clock.start();
+    m_timer.setInterval(1000 / m_maximumFrameRate);
+    QObject::connect(&m_timer, &QTimer::timeout, &m_timer, [this]() {
+        tick();
+    });
+}
+
+void KBusyIndicatorClock::add(KBusyIndicatorWidgetPrivate *indicator)
+{
+    m_indicators.push_back(indicator);
+    indicator->registered = true;
+    if (!m_timer.isActive()) {
+        m_timer.start();
+    }
+}
+
+void KBusyIndicatorClock::remove(KBusyIndicatorWidgetPrivate *indicator)
+{
+    m_indicators.erase(std::remove(m_indicators.begin(), m_indicators.end(), indicator), m_indicators.end());
+    indicator->registered = false;
+    if (m_indicators.empty()) {
+        m_timer.stop();
+    }
+}
+
+void KBusyIndicatorClock::setMaximumFrameRate(int framesPerSecond)
+{
+    m_maximumFrameRate = std::clamp(framesPerSecond, 1, 1000);
+    m_timer.setInterval(1000 / m_maximumFrameRate);
+}
+
+void KBusyIndicatorClock::tick()
+{
+    // The update requests of all indicators are handled in one go by the windows
+    const auto indicators = m_indicators;
+    for (KBusyIndicatorWidgetPrivate *indicator : indicators) {
+        if (indicator->isExposed()) {
+            // Nothing to do until the rotation reaches the next frame
+            if (indicator->frameIndex() != indicator->paintedFrame) {
+                indicator->q->update();
+            }
+        } else {
+            // Picked up again on the next paint, which happens once visible again
+            remove(indicator);
+        }
+    }
+}
+
 KBusyIndicatorWidget::KBusyIndicatorWidget(QWidget *parent)
     : QWidget(parent)
     , d(new KBusyIndicatorWidgetPrivate(this))
@@ -52,18 +272,25 @@ QSize KBusyIndicatorWidget::minimumSizeHint() const
 
 bool KBusyIndicatorWidget::isRunning() const
 {
-    return d->animation.state() == QAbstractAnimation::Running;
+    return d->running;
 }
 
 void KBusyIndicatorWidget::start()
 {
-    d->animation.start();
+    if (!d->running) {
+        d->startTime = s_clock()->elapsed();
+        d->running = true;
+    }
+    d->updateRegistration();
 }
 
 void KBusyIndicatorWidget::stop()
 {
-    if (d->animation.state() == QAbstractAnimation::Running) // avoid warning if never started yet
-        d->animation.pause();
+    if (d->running) {
+        d->stoppedRotation = d->rotation();
+        d->running = false;
+    }
+    d->updateRegistration();
 }
 
 void KBusyIndicatorWidget::setRunning(const bool enable)
@@ -74,6 +301,16 @@ void KBusyIndicatorWidget::setRunning(const bool enable)
         stop();
 }
 
+int KBusyIndicatorWidget::maximumFrameRate()
+{
+    return s_clock()->maximumFrameRate();
+}
+
+void KBusyIndicatorWidget::setMaximumFrameRate(int framesPerSecond)
+{
+    s_clock()->setMaximumFrameRate(framesPerSecond);
+}
+
 void KBusyIndicatorWidget::showEvent(QShowEvent *event)
 {
     QWidget::showEvent(event);
@@ -88,22 +325,24 @@ void KBusyIndicatorWidget::hideEvent(QHideEvent *event)
 
 void KBusyIndicatorWidget::resizeEvent(QResizeEvent *event)
 {
+    // The frames follow the size when painted, the override is only kept for binary compatibility
     QWidget::resizeEvent(event);
-    d->paintCenter = QPointF(event->size().width() / 2.0, //
-                             event->size().height() / 2.0);
 }
 
 void KBusyIndicatorWidget::paintEvent(QPaintEvent *)
 {
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    // Being painted means being visible again after having been covered or scrolled away
+    d->updateRegistration();
 
-    // Rotate around the center and then reset back to origin for icon painting.
-    painter.translate(d->paintCenter);
-    painter.rotate(d->rotation);
-    painter.translate(-d->paintCenter);
+    if (width() <= 0 || height() <= 0) {
+        return;
+    }
+
+    d->paintedFrame = d->frameIndex();
+    const QPixmap frame = s_frameCache()->frame(d->icon, size(), devicePixelRatioF(), d->paintedFrame);
 
-    d->icon.paint(&painter, rect());
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, frame);
 }
 
 bool KBusyIndicatorWidget::event(QEvent *event)
@@ -70,6 +70,30 @@ public:
      */
     bool isRunning() const;
 
+    /*!
+     * Returns the maximum number of frames per second the spinning
+     * animation of the indicators is updated with.
+     *
+     * \sa setMaximumFrameRate()
+     *
+     * \since 6.30
+     */
+    static int maximumFrameRate();
+
+    /*!
+     * Sets the maximum number of frames per second the spinning animation
+     * is updated with to \a framesPerSecond, for all indicators of the application.
+     *
+     * All running indicators are animated by a single shared timer. Indicators
+     * which cannot be seen, e.g. because their window is minimized, are not
+     * updated at all. The default is 60.
+     *
+     * \sa maximumFrameRate()
+     *
+     * \since 6.30
+     */
+    static void setMaximumFrameRate(int framesPerSecond);
+
 public Q_SLOTS:
     /*!
      * Start the spinning animation
@@ -17,6 +17,7 @@
 #include <kpopupframe.h>
 
 #include <QApplication>
+#include <QCache>
 #include <QComboBox>
 #include <QFont>
 #include <QFontDatabase>
@@ -73,6 +74,45 @@ private:
     KDatePicker *const picker;
 };
 
+namespace
+{
+struct WeeksKey {
+    int year;
+    QString localeName;
+    QString weekFormat; // translated
+    bool operator==(const WeeksKey &other) const
+    {
+        return year == other.year && localeName == other.localeName && weekFormat == other.weekFormat;
+    }
+};
+
+size_t qHash(const WeeksKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.year, key.localeName, key.weekFormat);
+}
+
+struct WeekEntry {
+    QString text;
+    QDate day; // a day of the week within the year
+};
+}
+
+// The entries of the week combo by year, shared by all date pickers,
+// so navigating back and forth between years does not compute them again
+class KDatePickerWeeksCache
+{
+public:
+    KDatePickerWeeksCache()
+    {
+        // Number of years
+        m_weeks.setMaxCost(32);
+    }
+
+    QCache<WeeksKey, QList<WeekEntry>> m_weeks;
+};
+
+Q_GLOBAL_STATIC(KDatePickerWeeksCache, s_weeksCache)
+
 // Week numbers are defined by ISO 8601
 // See http://www.merlyn.demon.co.uk/weekinfo.htm for details
 
@@ -136,6 +176,8 @@ public:
     }
 
     void fillWeeksCombo();
+    QList<WeekEntry> weekEntries(int year) const;
+    QMenu *monthMenu();
     QDate validDateInYearMonth(int year, int month);
 
     /// the date table
@@ -169,22 +211,48 @@ public:
 
     /// the font size for the widget
     int fontsize = -1;
+
+    /// what the week combo is filled for
+    WeeksKey weeksComboKey{0, QString(), QString()};
+    /// the month popup menu, kept for the locale it is filled for
+    QMenu *selectMonthMenu = nullptr;
+    QString selectMonthMenuLocale;
 };
 
 void KDatePickerPrivate::fillWeeksCombo()
 {
     // every year can have a different number of weeks
     // it could be that we had 53,1..52 and now 1..53 which is the same number but different
-    // so always fill with new values
+    // so fill with new values when the year changes
+    const int thisYear = q->date().year();
+    WeeksKey key{thisYear, q->locale().name(), tr("Week %1")};
+    if (key == weeksComboKey && selectWeek->count() > 0) {
+        return;
+    }
+
+    const QList<WeekEntry> *cachedEntries = s_weeksCache()->m_weeks.object(key);
+    const QList<WeekEntry> entries = cachedEntries ? *cachedEntries : weekEntries(thisYear);
+    if (!cachedEntries) {
+        s_weeksCache()->m_weeks.insert(key, new QList<WeekEntry>(entries));
+    }
+
+    selectWeek->clear();
+    for (const WeekEntry &entry : entries) {
+        selectWeek->addItem(entry.text, entry.day);
+    }
+    weeksComboKey = std::move(key);
+}
+
+QList<WeekEntry> KDatePickerPrivate::weekEntries(int year) const
+{
     // We show all week numbers for all weeks between first day of year to last day of year
     // This of course can be a list like 53,1,2..52
 
-    const QDate thisDate = q->date();
-    const int thisYear = thisDate.year();
-    QDate day(thisDate.year(), 1, 1);
-    const QDate lastDayOfYear = QDate(thisDate.year() + 1, 1, 1).addDays(-1);
+    QList<WeekEntry> entries;
+    entries.reserve(54);
 
-    selectWeek->clear();
+    QDate day(year, 1, 1);
+    const QDate lastDayOfYear = QDate(year + 1, 1, 1).addDays(-1);
 
     // Starting from the first day in the year, loop through the year a week at a time
     // adding an entry to the week combo for each week in the year
@@ -192,19 +260,18 @@ void KDatePickerPrivate::fillWeeksCombo()
     for (; day.isValid() && day <= lastDayOfYear; day = day.addDays(7)) {
         // Get the ISO week number for the current day and what year that week is in
         // e.g. 1st day of this year may fall in week 53 of previous year
-        int weekYear = thisYear;
+        int weekYear = year;
         const int week = day.weekNumber(&weekYear);
         QString weekString = tr("Week %1").arg(q->locale().toString(week));
 
         // show that this is a week from a different year
-        if (weekYear != thisYear) {
+        if (weekYear != year) {
             weekString += QLatin1Char('*');
         }
 
-        // when the week is selected, go to the same weekday as the one
-        // that is currently selected in the date table
-        QDate targetDate = day.addDays(thisDate.dayOfWeek() - day.dayOfWeek());
-        selectWeek->addItem(weekString, targetDate);
+        // when the week is selected, the same weekday as the one that is
+        // currently selected in the date table is picked from this day
+        entries.append(WeekEntry{weekString, day});
 
         // make sure that the week of the lastDayOfYear is always inserted: in Chinese calendar
         // system, this is not always the case
@@ -214,6 +281,30 @@ void KDatePickerPrivate::fillWeeksCombo()
             day = lastDayOfYear.addDays(-7);
         }
     }
+
+    return entries;
+}
+
+QMenu *KDatePickerPrivate::monthMenu()
+{
+    const QLocale locale = q->locale();
+    if (selectMonthMenu && selectMonthMenuLocale == locale.name()) {
+        return selectMonthMenu;
+    }
+
+    if (!selectMonthMenu) {
+        selectMonthMenu = new QMenu(selectMonth);
+    }
+    selectMonthMenu->clear();
+    selectMonthMenuLocale = locale.name();
+
+    // Populate the pick list with all the month names
+    // JPL do we need to do something here for months that fall outside valid range?
+    for (int m = 1; m <= 12; m++) {
+        selectMonthMenu->addAction(locale.standaloneMonthName(m))->setData(m);
+    }
+
+    return selectMonthMenu;
 }
 
 QDate KDatePickerPrivate::validDateInYearMonth(int year, int month)
@@ -450,7 +541,9 @@ void KDatePicker::yearBackwardClicked()
 
 void KDatePicker::weekSelected(int index)
 {
-    QDate targetDay = d->selectWeek->itemData(index).toDateTime().date();
+    // Go to the same weekday as the one currently selected in the date table
+    const QDate weekDay = d->selectWeek->itemData(index).toDate();
+    const QDate targetDay = weekDay.addDays(date().dayOfWeek() - weekDay.dayOfWeek());
 
     if (!setDate(targetDay)) {
         QApplication::beep();
@@ -463,22 +556,16 @@ void KDatePicker::selectMonthClicked()
     QDate thisDate(date());
     d->table->setFocus();
 
-    QMenu popup(d->selectMonth);
-    // Populate the pick list with all the month names, this may change by year
-    // JPL do we need to do something here for months that fall outside valid range?
-    const int monthsInYear = QDate(thisDate.year() + 1, 1, 1).addDays(-1).month();
-    for (int m = 1; m <= monthsInYear; m++) {
-        popup.addAction(locale().standaloneMonthName(m))->setData(m);
-    }
+    // The menu is only filled again when the locale changed
+    QMenu *popup = d->monthMenu();
 
-    QAction *item = popup.actions()[thisDate.month() - 1];
-    // if this happens the above should already given an assertion
+    QAction *item = popup->actions().value(thisDate.month() - 1);
     if (item) {
-        popup.setActiveAction(item);
+        popup->setActiveAction(item);
     }
 
     // cancelled
-    if ((item = popup.exec(d->selectMonth->mapToGlobal(QPoint(0, 0)), item)) == nullptr) {
+    if ((item = popup->exec(d->selectMonth->mapToGlobal(QPoint(0, 0)), item)) == nullptr) {
         return;
     }
 
@@ -666,4 +753,44 @@ void KDatePicker::setDateRange(const QDate &minDate, const QDate &maxDate)
     d->table->setDateRange(minDate, maxDate);
 }
 
+static_assert(int(KDatePicker::NoBgMode) == int(KDateTable::NoBgMode) && int(KDatePicker::RectangleMode) == int(KDateTable::RectangleMode)
+              && int(KDatePicker::CircleMode) == int(KDateTable::CircleMode));
+
+void KDatePicker::setCustomDatePainting(const QDate &date, const QColor &fgColor, BackgroundMode bgMode, const QColor &bgColor)
+{
+    d->table->setCustomDatePainting(date, fgColor, KDateTable::BackgroundMode(bgMode), bgColor);
+}
+
+void KDatePicker::setCustomDatePainting(const QDate &from, const QDate &to, const QColor &fgColor, BackgroundMode bgMode, const QColor &bgColor)
+{
+    d->table->setCustomDatePainting(from, to, fgColor, KDateTable::BackgroundMode(bgMode), bgColor);
+}
+
+void KDatePicker::unsetCustomDatePainting(const QDate &date)
+{
+    d->table->unsetCustomDatePainting(date);
+}
+
+void KDatePicker::unsetCustomDatePainting(const QDate &from, const QDate &to)
+{
+    d->table->unsetCustomDatePainting(from, to);
+}
+
+void KDatePicker::setCustomDatePaintingProvider(const DatePaintingProvider &provider)
+{
+    if (!provider) {
+        d->table->setCustomDatePaintingProvider({});
+        return;
+    }
+
+    d->table->setCustomDatePaintingProvider([provider](const QDate &first, const QDate &last) {
+        const QMap<QDate, DatePainting> paintings = provider(first, last);
+        QMap<QDate, KDateTable::DatePainting> tablePaintings;
+        for (auto it = paintings.cbegin(); it != paintings.cend(); ++it) {
+            tablePaintings.insert(it.key(), {it->fgColor, KDateTable::BackgroundMode(it->bgMode), it->bgColor});
+        }
+        return tablePaintings;
+    });
+}
+
 #include "kdatepicker.moc"
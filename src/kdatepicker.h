@@ -12,8 +12,11 @@
 
 #include <kwidgetsaddons_export.h>
 
+#include <QColor>
 #include <QDate>
 #include <QFrame>
+#include <QMap>
+#include <functional>
 #include <memory>
 
 class QLineEdit;
@@ -130,6 +133,105 @@ public:
      */
     void setDateRange(const QDate &minDate, const QDate &maxDate = QDate());
 
+    /*!
+     * \enum KDatePicker::BackgroundMode
+     *
+     * The background painted behind a date with custom painting.
+     *
+     * \value NoBgMode No background
+     * \value RectangleMode A rectangle filling the cell of the date
+     * \value CircleMode A circle, or an ellipse, filling the cell of the date
+     *
+     * \since 6.30
+     */
+    enum BackgroundMode {
+        NoBgMode = 0,
+        RectangleMode,
+        CircleMode,
+    };
+    Q_ENUM(BackgroundMode)
+
+    /*!
+     * \class KDatePicker::DatePainting
+     * \inmodule KWidgetsAddons
+     *
+     * The custom painting of a date.
+     *
+     * \since 6.30
+     */
+    struct DatePainting {
+        /*!
+         * The color of the day number.
+         */
+        QColor fgColor;
+        /*!
+         * The kind of background painted behind the day number.
+         */
+        BackgroundMode bgMode = NoBgMode;
+        /*!
+         * The color of the background, unused with NoBgMode.
+         */
+        QColor bgColor;
+    };
+
+    /*!
+     * Returns the custom painting of the dates from \a first to \a last, inclusive,
+     * dates without custom painting are left out.
+     *
+     * \since 6.30
+     */
+    using DatePaintingProvider = std::function<QMap<QDate, DatePainting>(const QDate &first, const QDate &last)>;
+
+    /*!
+     * Makes \a date be painted with the foreground color \a fgColor
+     * and a background of kind \a bgMode in the color \a bgColor.
+     *
+     * If custom painting was set for the date before, the most recent one is used.
+     *
+     * \sa unsetCustomDatePainting()
+     * \since 6.30
+     */
+    void setCustomDatePainting(const QDate &date, const QColor &fgColor, BackgroundMode bgMode = NoBgMode, const QColor &bgColor = QColor());
+
+    /*!
+     * Makes all dates from \a from to \a to, inclusive, be painted like
+     * setCustomDatePainting() does for a single date.
+     *
+     * Ranges are kept as such, so marking even years of dates is cheap.
+     *
+     * \since 6.30
+     */
+    void setCustomDatePainting(const QDate &from, const QDate &to, const QColor &fgColor, BackgroundMode bgMode = NoBgMode, const QColor &bgColor = QColor());
+
+    /*!
+     * Unsets the custom painting of \a date, so that it is painted as usual.
+     *
+     * \since 6.30
+     */
+    void unsetCustomDatePainting(const QDate &date);
+
+    /*!
+     * Unsets the custom painting of all dates from \a from to \a to, inclusive.
+     * Ranges set before that only partly overlap are kept for the other dates.
+     *
+     * \since 6.30
+     */
+    void unsetCustomDatePainting(const QDate &from, const QDate &to);
+
+    /*!
+     * Sets a \a provider of custom painting, asked once for the dates
+     * shown whenever another month is shown.
+     *
+     * This suits data kept elsewhere, e.g. the events of a calendar,
+     * as only the shown dates are looked up.
+     * Custom painting set by setCustomDatePainting() takes precedence.
+     * Setting the provider again, also the same one, asks it again, e.g.
+     * after its data changed. Pass an empty function to unset it.
+     *
+     * \since 6.30
+     */
+    void setCustomDatePaintingProvider(const DatePaintingProvider &provider);
+
 protected:
     // to catch move keyEvents when QLineEdit has keyFocus
     bool eventFilter(QObject *o, QEvent *e) override;
@@ -16,15 +16,132 @@
 #include <QApplication>
 #include <QDate>
 #include <QFontDatabase>
+#include <QLocale>
 #include <QMenu>
 #include <QPainter>
 #include <QStyle>
 #include <QStyleOptionViewItem>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 #include "kdaterangecontrol_p.h"
 
+/*
+ * Custom painting of date ranges, as Julian days.
+ *
+ * The ranges are kept ordered by their first day, as an implicit balanced
+ * binary tree where each node knows the largest last day in its subtree,
+ * i.e. an interval tree. Finding the ranges overlapping the shown month
+ * so only visits a few of them, whatever the total number is. The tree is
+ * only rebuilt on the first query after changes, so adding many ranges
+ * one by one stays cheap.
+ */
+class KDateTablePaintedRanges
+{
+public:
+    struct Range {
+        qint64 first;
+        qint64 last;
+        quint64 serial; // the most recently set painting wins
+        KDateTable::DatePainting painting;
+    };
+
+    bool isEmpty() const
+    {
+        return m_ranges.empty();
+    }
+
+    void insert(const Range &range)
+    {
+        m_ranges.push_back(range);
+        m_dirty = true;
+    }
+
+    // Removes the days from first to last of all ranges
+    void remove(qint64 first, qint64 last)
+    {
+        std::vector<Range> remaining;
+        remaining.reserve(m_ranges.size());
+        for (const Range &range : m_ranges) {
+            if (range.last < first || range.first > last) {
+                remaining.push_back(range);
+                continue;
+            }
+            if (range.first < first) {
+                remaining.push_back(Range{range.first, first - 1, range.serial, range.painting});
+            }
+            if (range.last > last) {
+                remaining.push_back(Range{last + 1, range.last, range.serial, range.painting});
+            }
+        }
+        m_ranges = std::move(remaining);
+        m_dirty = true;
+    }
+
+    // Calls f for all ranges overlapping the days from first to last
+    template<typename F>
+    void forEachOverlapping(qint64 first, qint64 last, F f)
+    {
+        if (m_dirty) {
+            rebuild();
+        }
+        visit(0, m_ranges.size(), first, last, f);
+    }
+
+private:
+    void rebuild()
+    {
+        std::sort(m_ranges.begin(), m_ranges.end(), [](const Range &a, const Range &b) {
+            return a.first < b.first;
+        });
+        m_maxLast.resize(m_ranges.size());
+        build(0, m_ranges.size());
+        m_dirty = false;
+    }
+
+    // The node of the subtree of the ranges from begin to end is the one in the middle
+    qint64 build(size_t begin, size_t end)
+    {
+        if (begin >= end) {
+            return std::numeric_limits<qint64>::min();
+        }
+        const size_t middle = begin + (end - begin) / 2;
+        const qint64 maxLast = std::max({m_ranges[middle].last, build(begin, middle), build(middle + 1, end)});
+        m_maxLast[middle] = maxLast;
+        return maxLast;
+    }
+
+    template<typename F>
+    void visit(size_t begin, size_t end, qint64 first, qint64 last, F &f) const
+    {
+        if (begin >= end) {
+            return;
+        }
+        const size_t middle = begin + (end - begin) / 2;
+        if (m_maxLast[middle] < first) {
+            // All ranges of this subtree end before
+            return;
+        }
+        visit(begin, middle, first, last, f);
+        const Range &range = m_ranges[middle];
+        if (range.first > last) {
+            // This one and all later ones start after
+            return;
+        }
+        if (range.last >= first) {
+            f(range);
+        }
+        visit(middle + 1, end, first, last, f);
+    }
+
+    std::vector<Range> m_ranges;
+    std::vector<qint64> m_maxLast;
+    bool m_dirty = false;
+};
+
 class KDateTable::KDateTablePrivate : public KDateRangeControlPrivate
 {
 public:
@@ -49,6 +166,11 @@ public:
     void beginningOfWeek();
     void endOfWeek();
 
+    void invalidateCells();
+    void ensureCells();
+    // Schedules a repaint of the day cell at pos
+    void updateCell(int pos);
+
     KDateTable *q;
 
     /*
@@ -89,16 +211,286 @@ public:
     bool m_popupMenuEnabled;
     bool m_useCustomColors;
 
-    struct DatePaintingMode {
-        QColor fgColor;
-        QColor bgColor;
-        BackgroundMode bgMode;
+    struct DatePaintingEntry {
+        DatePainting painting;
+        quint64 serial;
     };
-    QHash<int, DatePaintingMode> m_customPaintingModes;
+    // Custom painting of single dates, by Julian day
+    QHash<qint64, DatePaintingEntry> m_customPaintingModes;
+    KDateTablePaintedRanges m_customPaintingRanges;
+    quint64 m_customPaintingSerial = 0;
+
+    DatePaintingProvider m_customPaintingProvider;
+    // What the provider returned for the dates from m_providedFirst to m_providedLast
+    QMap<QDate, DatePainting> m_providedPaintings;
+    QDate m_providedFirst;
+    QDate m_providedLast;
+
+    void updateUseCustomColors();
+    // Fills m_visiblePaintings with the custom painting of the count dates from first on
+    void collectCustomPaintings(const QDate &first, int count);
+    std::vector<const DatePainting *> m_visiblePaintings;
 
     int m_hoveredPos;
+
+    /*
+     * What is drawn in a cell, computed once for the shown month.
+     */
+    struct Cell {
+        QString text;
+        QColor textColor;
+        QColor backgroundColor;
+        bool bold = false;
+        // Whether the background differs from the one of the table
+        bool highlighted = false;
+    };
+
+    /*
+     * The cells row by row, including the header row, empty if outdated.
+     */
+    QList<Cell> m_cells;
+
+    /*
+     * The current date when m_cells was computed, as it is shown differently.
+     */
+    QDate m_cellsCurrentDate;
+
+    /*
+     * The fonts of the cells, also computed with m_cells.
+     */
+    QFont m_font;
+    QFont m_boldFont;
 };
 
+void KDateTable::KDateTablePrivate::updateUseCustomColors()
+{
+    m_useCustomColors = !m_customPaintingModes.isEmpty() || !m_customPaintingRanges.isEmpty() || m_customPaintingProvider;
+}
+
+void KDateTable::KDateTablePrivate::collectCustomPaintings(const QDate &first, int count)
+{
+    m_visiblePaintings.assign(count, nullptr);
+    if (!m_useCustomColors || !first.isValid()) {
+        return;
+    }
+
+    const QDate last = first.addDays(count - 1);
+    const qint64 firstDay = first.toJulianDay();
+    const qint64 lastDay = last.toJulianDay();
+    std::vector<quint64> serials(count, 0);
+
+    // Lowest precedence first
+    if (m_customPaintingProvider) {
+        if (first != m_providedFirst || last != m_providedLast) {
+            m_providedPaintings = m_customPaintingProvider(first, last);
+            m_providedFirst = first;
+            m_providedLast = last;
+        }
+        const QMap<QDate, DatePainting> &provided = m_providedPaintings;
+        for (auto it = provided.lowerBound(first); it != provided.cend() && it.key() <= last; ++it) {
+            m_visiblePaintings[it.key().toJulianDay() - firstDay] = &it.value();
+        }
+    }
+
+    m_customPaintingRanges.forEachOverlapping(firstDay, lastDay, [&](const KDateTablePaintedRanges::Range &range) {
+        for (qint64 day = std::max(range.first, firstDay); day <= std::min(range.last, lastDay); ++day) {
+            const qint64 index = day - firstDay;
+            if (range.serial > serials[index]) {
+                serials[index] = range.serial;
+                m_visiblePaintings[index] = &range.painting;
+            }
+        }
+    });
+
+    if (!m_customPaintingModes.isEmpty()) {
+        for (int index = 0; index < count; ++index) {
+            const auto it = m_customPaintingModes.constFind(firstDay + index);
+            if (it != m_customPaintingModes.constEnd() && it->serial > serials[index]) {
+                serials[index] = it->serial;
+                m_visiblePaintings[index] = &it->painting;
+            }
+        }
+    }
+}
+
+void KDateTable::KDateTablePrivate::invalidateCells()
+{
+    m_cells.clear();
+}
+
+void KDateTable::KDateTablePrivate::ensureCells()
+{
+    const QDate currentDate = QDate::currentDate();
+    if (!m_cells.isEmpty() && m_cellsCurrentDate == currentDate) {
+        return;
+    }
+
+    const QLocale locale = q->locale();
+    const QPalette palette = q->palette();
+    const int firstDayOfWeek = locale.firstDayOfWeek();
+    const QList<Qt::DayOfWeek> weekdays = locale.weekdays();
+    const bool highContrast = isHighContrastColorSchemeInUse();
+    const QColor tableBackgroundColor = palette.color(q->backgroundRole());
+
+    m_cells.resize(m_numWeekRows * m_numDayColumns);
+    m_cellsCurrentDate = currentDate;
+    m_font = QFontDatabase::systemFont(QFontDatabase::GeneralFont);
+    m_boldFont = m_font;
+    m_boldFont.setBold(true);
+
+    // Only the custom painting of the shown days is looked up
+    const int dayCellCount = m_numDayColumns * (m_numWeekRows - 1);
+    collectCustomPaintings(q->dateFromPos(0), dayCellCount);
+
+    for (int row = 0; row < m_numWeekRows; ++row) {
+        for (int col = 0; col < m_numDayColumns; ++col) {
+            Cell &cell = m_cells[row * m_numDayColumns + col];
+            cell = Cell();
+
+            // Calculate what day of the week the cell is
+            int cellWeekDay;
+            if (col + firstDayOfWeek <= m_numDayColumns) {
+                cellWeekDay = col + firstDayOfWeek;
+            } else {
+                cellWeekDay = col + firstDayOfWeek - m_numDayColumns;
+            }
+
+            // FIXME This is wrong if the widget is not using the global!
+            // See if cell day is normally a working day
+            bool workingDay = false;
+            if (weekdays.first() <= weekdays.last()) {
+                if (cellWeekDay >= weekdays.first() && cellWeekDay <= weekdays.last()) {
+                    workingDay = true;
+                }
+            } else {
+                if (cellWeekDay >= weekdays.first() //
+                    || cellWeekDay <= weekdays.last()) {
+                    workingDay = true;
+                }
+            }
+
+            if (row == 0) {
+                // A header cell
+
+                // If not a normal working day, then use "do not work today" color
+                if (!workingDay && !highContrast) {
+                    cell.textColor = Qt::darkRed;
+                } else {
+                    cell.textColor = palette.color(QPalette::WindowText);
+                }
+                cell.backgroundColor = palette.color(QPalette::Window);
+
+                // Set the text to the short day name and bold it
+                cell.bold = true;
+                cell.text = locale.dayName(cellWeekDay, QLocale::ShortFormat);
+                continue;
+            }
+
+            // A day cell
+
+            // Calculate the date the cell represents
+            const QDate cellDate = q->dateFromPos(m_numDayColumns * (row - 1) + col);
+
+            const bool validDay = cellDate.isValid();
+
+            // Draw the day number in the cell, if the date is not valid then we don't want to show it
+            if (validDay) {
+                cell.text = locale.toString(cellDate.day());
+            }
+
+            if (!validDay || cellDate.month() != m_date.month()) {
+                // we are either
+                // ° painting an invalid day
+                // ° painting a day of the previous month or
+                // ° painting a day of the following month or
+                cell.backgroundColor = tableBackgroundColor;
+                cell.textColor = palette.color(QPalette::Disabled, QPalette::Text);
+            } else {
+                // Paint a day of the current month
+
+                // Background Colour priorities will be (high-to-low):
+                // * Selected Day Background Colour
+                // * Customized Day Background Colour
+                // * Normal Day Background Colour
+
+                // Background Shape priorities will be (high-to-low):
+                // * Customized Day Shape
+                // * Normal Day Shape
+
+                // Text Colour priorities will be (high-to-low):
+                // * Customized Day Colour
+                // * Day of Pray Colour (Red letter)
+                // * Selected Day Colour
+                // * Normal Day Colour
+
+                // Determine various characteristics of the cell date
+                const bool selectedDay = (cellDate == m_date);
+                const bool currentDay = (cellDate == currentDate);
+                const bool dayOfPray = (cellDate.dayOfWeek() == Qt::Sunday);
+                // TODO: Uncomment if QLocale ever gets the feature...
+                // bool dayOfPray = ( cellDate.dayOfWeek() == locale().dayOfPray() );
+                const DatePainting *customMode = m_visiblePaintings[m_numDayColumns * (row - 1) + col];
+                const bool customDay = customMode != nullptr;
+
+                // Default values for a normal cell
+                cell.backgroundColor = tableBackgroundColor;
+                cell.textColor = palette.color(q->foregroundRole());
+
+                // If we are drawing the current date, then draw it bold and active
+                if (currentDay) {
+                    cell.bold = true;
+                    cell.textColor = palette.color(QPalette::LinkVisited);
+                }
+
+                // if we are drawing the day cell currently selected in the table
+                if (selectedDay) {
+                    // set the background to highlighted
+                    cell.backgroundColor = palette.color(QPalette::Highlight);
+                    cell.textColor = palette.color(QPalette::HighlightedText);
+                }
+
+                // If custom colors or shape are required for this date
+                if (customDay) {
+                    if (customMode->bgMode != NoBgMode) {
+                        if (!selectedDay) {
+                            cell.backgroundColor = customMode->bgColor;
+                        }
+                    }
+                    cell.textColor = customMode->fgColor;
+                }
+
+                // If the cell day is the day of religious observance, then always color text red unless Custom overrides
+                if (!customDay && dayOfPray && !highContrast) {
+                    cell.textColor = Qt::darkRed;
+                }
+            }
+
+            // If the cell day is out of the allowed range, paint it as disabled
+            if (!isInDateRange(cellDate)) {
+                cell.backgroundColor = palette.color(QPalette::Disabled, q->backgroundRole());
+            }
+
+            cell.highlighted = cell.backgroundColor != tableBackgroundColor;
+        }
+    }
+}
+
+void KDateTable::KDateTablePrivate::updateCell(int pos)
+{
+    if (pos < 0 || pos >= m_numDayColumns * (m_numWeekRows - 1)) {
+        return;
+    }
+
+    const int row = pos / m_numDayColumns + 1;
+    int col = pos % m_numDayColumns;
+    if (q->layoutDirection() == Qt::RightToLeft) {
+        col = m_numDayColumns - col - 1;
+    }
+    const double cellWidth = q->width() / (double)m_numDayColumns;
+    const double cellHeight = q->height() / (double)m_numWeekRows;
+    q->update(QRectF(col * cellWidth, row * cellHeight, cellWidth, cellHeight).toAlignedRect());
+}
+
 KDateTable::KDateTable(const QDate &date, QWidget *parent)
     : QWidget(parent)
     , d(new KDateTablePrivate(this))
@@ -211,6 +603,8 @@ QDate KDateTable::dateFromPos(int position)
 
 void KDateTable::paintEvent(QPaintEvent *e)
 {
+    d->ensureCells();
+
     QPainter p(this);
     const QRect &rectToUpdate = e->rect();
     double cellWidth = width() / (double)d->m_numDayColumns;
@@ -245,150 +639,23 @@ void KDateTable::paintCell(QPainter *painter, int row, int col)
     double w = (width() / (double)d->m_numDayColumns) - 1;
     double h = (height() / (double)d->m_numWeekRows) - 1;
     QRectF cell = QRectF(0, 0, w, h);
-    QString cellText;
-    QColor cellBackgroundColor;
-    QColor cellTextColor;
-    QFont cellFont = QFontDatabase::systemFont(QFontDatabase::GeneralFont);
-    bool workingDay = false;
-    int cellWeekDay;
-    int pos;
 
     // Calculate the position of the cell in the grid
-    pos = d->m_numDayColumns * (row - 1) + col;
-
-    // Calculate what day of the week the cell is
-    if (col + locale().firstDayOfWeek() <= d->m_numDayColumns) {
-        cellWeekDay = col + locale().firstDayOfWeek();
-    } else {
-        cellWeekDay = col + locale().firstDayOfWeek() - d->m_numDayColumns;
-    }
-
-    // FIXME This is wrong if the widget is not using the global!
-    // See if cell day is normally a working day
-    if (locale().weekdays().first() <= locale().weekdays().last()) {
-        if (cellWeekDay >= locale().weekdays().first() && cellWeekDay <= locale().weekdays().last()) {
-            workingDay = true;
-        }
-    } else {
-        if (cellWeekDay >= locale().weekdays().first() //
-            || cellWeekDay <= locale().weekdays().last()) {
-            workingDay = true;
-        }
-    }
-
-    if (row == 0) {
-        // We are drawing a header cell
-
-        // If not a normal working day, then use "do not work today" color
-        if (!workingDay && !isHighContrastColorSchemeInUse()) {
-            cellTextColor = Qt::darkRed;
-        } else {
-            cellTextColor = palette().color(QPalette::WindowText);
-        }
-        cellBackgroundColor = palette().color(QPalette::Window);
-
-        // Set the text to the short day name and bold it
-        cellFont.setBold(true);
-        cellText = locale().dayName(cellWeekDay, QLocale::ShortFormat);
-
-    } else {
-        // We are drawing a day cell
-
-        // Calculate the date the cell represents
-        QDate cellDate = dateFromPos(pos);
-
-        bool validDay = cellDate.isValid();
-
-        // Draw the day number in the cell, if the date is not valid then we don't want to show it
-        if (validDay) {
-            cellText = locale().toString(cellDate.day());
-        } else {
-            cellText = QString();
-        }
-
-        if (!validDay || cellDate.month() != d->m_date.month()) {
-            // we are either
-            // ° painting an invalid day
-            // ° painting a day of the previous month or
-            // ° painting a day of the following month or
-            cellBackgroundColor = palette().color(backgroundRole());
-            cellTextColor = palette().color(QPalette::Disabled, QPalette::Text);
-        } else {
-            // Paint a day of the current month
-
-            // Background Colour priorities will be (high-to-low):
-            // * Selected Day Background Colour
-            // * Customized Day Background Colour
-            // * Normal Day Background Colour
-
-            // Background Shape priorities will be (high-to-low):
-            // * Customized Day Shape
-            // * Normal Day Shape
-
-            // Text Colour priorities will be (high-to-low):
-            // * Customized Day Colour
-            // * Day of Pray Colour (Red letter)
-            // * Selected Day Colour
-            // * Normal Day Colour
-
-            // Determine various characteristics of the cell date
-            bool selectedDay = (cellDate == date());
-            bool currentDay = (cellDate == QDate::currentDate());
-            bool dayOfPray = (cellDate.dayOfWeek() == Qt::Sunday);
-            // TODO: Uncomment if QLocale ever gets the feature...
-            // bool dayOfPray = ( cellDate.dayOfWeek() == locale().dayOfPray() );
-            bool customDay = (d->m_useCustomColors && d->m_customPaintingModes.contains(cellDate.toJulianDay()));
-
-            // Default values for a normal cell
-            cellBackgroundColor = palette().color(backgroundRole());
-            cellTextColor = palette().color(foregroundRole());
-
-            // If we are drawing the current date, then draw it bold and active
-            if (currentDay) {
-                cellFont.setBold(true);
-                cellTextColor = palette().color(QPalette::LinkVisited);
-            }
-
-            // if we are drawing the day cell currently selected in the table
-            if (selectedDay) {
-                // set the background to highlighted
-                cellBackgroundColor = palette().color(QPalette::Highlight);
-                cellTextColor = palette().color(QPalette::HighlightedText);
-            }
-
-            // If custom colors or shape are required for this date
-            if (customDay) {
-                KDateTablePrivate::DatePaintingMode mode = d->m_customPaintingModes[cellDate.toJulianDay()];
-                if (mode.bgMode != NoBgMode) {
-                    if (!selectedDay) {
-                        cellBackgroundColor = mode.bgColor;
-                    }
-                }
-                cellTextColor = mode.fgColor;
-            }
+    const int pos = d->m_numDayColumns * (row - 1) + col;
 
-            // If the cell day is the day of religious observance, then always color text red unless Custom overrides
-            if (!customDay && dayOfPray && !isHighContrastColorSchemeInUse()) {
-                cellTextColor = Qt::darkRed;
-            }
-        }
-
-        // If the cell day is out of the allowed range, paint it as disabled
-        if (!d->isInDateRange(cellDate)) {
-            cellBackgroundColor = palette().color(QPalette::Disabled, backgroundRole());
-        }
-    }
+    const KDateTablePrivate::Cell &cellData = d->m_cells.at(row * d->m_numDayColumns + col);
+    const QColor &cellBackgroundColor = cellData.backgroundColor;
 
     // Draw the background
     if (row == 0) {
         painter->setPen(cellBackgroundColor);
         painter->setBrush(cellBackgroundColor);
         painter->drawRect(cell);
-    } else if (cellBackgroundColor != palette().color(backgroundRole()) || pos == d->m_hoveredPos) {
+    } else if (cellData.highlighted || pos == d->m_hoveredPos) {
         QStyleOptionViewItem opt;
         opt.initFrom(this);
         opt.rect = cell.toRect();
-        if (cellBackgroundColor != palette().color(backgroundRole())) {
+        if (cellData.highlighted) {
             opt.palette.setBrush(QPalette::Highlight, cellBackgroundColor);
             opt.state |= QStyle::State_Selected;
         }
@@ -403,9 +670,9 @@ void KDateTable::paintCell(QPainter *painter, int row, int col)
     }
 
     // Draw the text
-    painter->setPen(cellTextColor);
-    painter->setFont(cellFont);
-    painter->drawText(cell, Qt::AlignCenter, cellText, &cell);
+    painter->setPen(cellData.textColor);
+    painter->setFont(cellData.bold ? d->m_boldFont : d->m_font);
+    painter->drawText(cell, Qt::AlignCenter, cellData.text, &cell);
 
     // Draw the base line
     if (row == 0) {
@@ -551,15 +818,16 @@ bool KDateTable::event(QEvent *ev)
         const int pos = row < 1 ? -1 : (d->m_numDayColumns * (row - 1)) + col;
 
         if (pos != d->m_hoveredPos) {
+            d->updateCell(d->m_hoveredPos);
             d->m_hoveredPos = pos;
-            update();
+            d->updateCell(d->m_hoveredPos);
         }
         break;
     }
     case QEvent::HoverLeave:
         if (d->m_hoveredPos != -1) {
+            d->updateCell(d->m_hoveredPos);
             d->m_hoveredPos = -1;
-            update();
         }
         break;
     default:
@@ -609,14 +877,9 @@ void KDateTable::mousePressEvent(QMouseEvent *e)
     // set the new date. If it is in the previous or next month, the month will
     // automatically be changed, no need to do that manually...
     // validity checking done inside setDate
+    // setDate() also schedules the repaint of the old and new cell
     setDate(clickedDate);
 
-    // This could be optimized to only call update over the regions
-    // of old and new cell, but 99% of times there is also a call to
-    // setDate that already calls update() so no need to optimize that
-    // much here
-    update();
-
     Q_EMIT tableClicked();
 
     if (e->button() == Qt::RightButton && d->m_popupMenuEnabled) {
@@ -649,9 +912,17 @@ bool KDateTable::setDate(const QDate &toDate)
         return false;
     }
 
+    const QDate oldDate = d->m_date;
     d->setDate(toDate);
+    d->invalidateCells();
     Q_EMIT dateChanged(date());
-    update();
+    if (oldDate.year() == toDate.year() && oldDate.month() == toDate.month()) {
+        // Same month, only the selection moved
+        d->updateCell(posFromDate(oldDate) - 1);
+        d->updateCell(posFromDate(toDate) - 1);
+    } else {
+        update();
+    }
 
     return true;
 }
@@ -663,6 +934,8 @@ const QDate &KDateTable::date() const
 
 void KDateTable::focusInEvent(QFocusEvent *e)
 {
+    // Repaints the whole table, as all highlighted cells show the focus,
+    // cheap enough with the cells computed already
     QWidget::focusInEvent(e);
 }
 
@@ -671,6 +944,22 @@ void KDateTable::focusOutEvent(QFocusEvent *e)
     QWidget::focusOutEvent(e);
 }
 
+void KDateTable::changeEvent(QEvent *e)
+{
+    switch (e->type()) {
+    case QEvent::FontChange:
+    case QEvent::LocaleChange:
+    case QEvent::PaletteChange:
+    case QEvent::StyleChange:
+        d->invalidateCells();
+        update();
+        break;
+    default:
+        break;
+    }
+    QWidget::changeEvent(e);
+}
+
 QSize KDateTable::sizeHint() const
 {
     if (d->m_maxCell.height() > 0 && d->m_maxCell.width() > 0) {
@@ -698,28 +987,97 @@ void KDateTable::setCustomDatePainting(const QDate &date, const QColor &fgColor,
         return;
     }
 
-    KDateTablePrivate::DatePaintingMode mode;
-    mode.bgMode = bgMode;
-    mode.fgColor = fgColor;
-    mode.bgColor = bgColor;
+    KDateTablePrivate::DatePaintingEntry entry;
+    entry.painting.bgMode = bgMode;
+    entry.painting.fgColor = fgColor;
+    entry.painting.bgColor = bgColor;
+    entry.serial = ++d->m_customPaintingSerial;
 
-    d->m_customPaintingModes.insert(date.toJulianDay(), mode);
+    d->m_customPaintingModes.insert(date.toJulianDay(), entry);
     d->m_useCustomColors = true;
+    d->invalidateCells();
+    update();
+}
+
+void KDateTable::setCustomDatePainting(const QDate &from, const QDate &to, const QColor &fgColor, BackgroundMode bgMode, const QColor &bgColor)
+{
+    if (!from.isValid() || !to.isValid() || from > to) {
+        return;
+    }
+
+    if (!fgColor.isValid()) {
+        unsetCustomDatePainting(from, to);
+        return;
+    }
+
+    KDateTablePaintedRanges::Range range;
+    range.first = from.toJulianDay();
+    range.last = to.toJulianDay();
+    range.serial = ++d->m_customPaintingSerial;
+    range.painting.bgMode = bgMode;
+    range.painting.fgColor = fgColor;
+    range.painting.bgColor = bgColor;
+
+    d->m_customPaintingRanges.insert(range);
+    d->m_useCustomColors = true;
+    d->invalidateCells();
     update();
 }
 
 void KDateTable::unsetCustomDatePainting(const QDate &date)
 {
-    d->m_customPaintingModes.remove(date.toJulianDay());
-    if (d->m_customPaintingModes.isEmpty()) {
-        d->m_useCustomColors = false;
+    unsetCustomDatePainting(date, date);
+}
+
+void KDateTable::unsetCustomDatePainting(const QDate &from, const QDate &to)
+{
+    if (!from.isValid() || !to.isValid() || from > to) {
+        return;
+    }
+
+    const qint64 first = from.toJulianDay();
+    const qint64 last = to.toJulianDay();
+    if (last - first < d->m_customPaintingModes.size()) {
+        for (qint64 day = first; day <= last; ++day) {
+            d->m_customPaintingModes.remove(day);
+        }
+    } else {
+        for (auto it = d->m_customPaintingModes.begin(); it != d->m_customPaintingModes.end();) {
+            if (it.key() >= first && it.key() <= last) {
+                it = d->m_customPaintingModes.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    if (!d->m_customPaintingRanges.isEmpty()) {
+        d->m_customPaintingRanges.remove(first, last);
     }
+
+    d->updateUseCustomColors();
+    d->invalidateCells();
+    update();
+}
+
+void KDateTable::setCustomDatePaintingProvider(const DatePaintingProvider &provider)
+{
+    d->m_customPaintingProvider = provider;
+    // Ask again, also if it is the same one
+    d->m_providedPaintings.clear();
+    d->m_providedFirst = QDate();
+    d->m_providedLast = QDate();
+
+    d->updateUseCustomColors();
+    d->invalidateCells();
     update();
 }
 
 void KDateTable::setDateRange(const QDate &minDate, const QDate &maxDate)
 {
-    d->setDateRange(minDate, maxDate);
+    if (d->setDateRange(minDate, maxDate)) {
+        d->invalidateCells();
+        update();
+    }
 }
 
 #include "moc_kdatetable_p.cpp"
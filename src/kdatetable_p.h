@@ -10,7 +10,12 @@
 #ifndef KDATETABLE_H
 #define KDATETABLE_H
 
+#include <QColor>
+#include <QDate>
+#include <QMap>
 #include <QWidget>
+
+#include <functional>
 #include <memory>
 
 class QMenu;
@@ -92,17 +97,57 @@ public:
         CircleMode
     };
 
+    /*!
+     * The custom painting of a date.
+     */
+    struct DatePainting {
+        QColor fgColor;
+        BackgroundMode bgMode = NoBgMode;
+        QColor bgColor;
+    };
+
+    /*!
+     * Returns the custom painting of the dates from \a first to \a last, inclusive.
+     */
+    using DatePaintingProvider = std::function<QMap<QDate, DatePainting>(const QDate &first, const QDate &last)>;
+
     /*!
      * Makes a given date be painted with a given foregroundColor, and background
      * (a rectangle, or a circle/ellipse) in a given color.
+     *
+     * If custom painting was set for the date before, the most recent one is used.
      */
     void setCustomDatePainting(const QDate &date, const QColor &fgColor, BackgroundMode bgMode = NoBgMode, const QColor &bgColor = QColor());
 
+    /*!
+     * Makes all dates from \a from to \a to, inclusive, be painted like
+     * setCustomDatePainting() does for a single date.
+     *
+     * Ranges are kept as such, so marking even years of dates is cheap and
+     * painting a month only looks at the ranges overlapping it.
+     */
+    void setCustomDatePainting(const QDate &from, const QDate &to, const QColor &fgColor, BackgroundMode bgMode = NoBgMode, const QColor &bgColor = QColor());
+
     /*!
      * Unsets the custom painting of a date so that the date is painted as usual.
      */
     void unsetCustomDatePainting(const QDate &date);
 
+    /*!
+     * Unsets the custom painting of all dates from \a from to \a to, inclusive.
+     */
+    void unsetCustomDatePainting(const QDate &from, const QDate &to);
+
+    /*!
+     * Sets a \a provider of custom painting, asked once for the dates
+     * shown whenever the table shows another month.
+     *
+     * Custom painting set by setCustomDatePainting() takes precedence.
+     * Setting the provider again, also the same one, asks it again, e.g.
+     * after its data changed. Pass an empty function to unset it.
+     */
+    void setCustomDatePaintingProvider(const DatePaintingProvider &provider);
+
     /**
      * Sets the valid date range. Dates outside this range will be styled differently and cannot be selected.
      */
@@ -131,6 +176,7 @@ protected:
     void keyPressEvent(QKeyEvent *e) override;
     void focusInEvent(QFocusEvent *e) override;
     void focusOutEvent(QFocusEvent *e) override;
+    void changeEvent(QEvent *e) override;
 
     /*!
      * Cell highlight on mouse hovering
@@ -17,12 +17,19 @@
 
 #include "kfontaction.h"
 
+#include "kfontfamilymodel_p.h"
 #include "kselectaction_p.h"
 
 #include <QFontComboBox>
+#include <QGlobalStatic>
+#include <QGuiApplication>
+#include <QHash>
 
 #include <kfontchooser.h>
 
+#include <map>
+#include <memory>
+
 class KFontActionPrivate : public KSelectActionPrivate
 {
     Q_DECLARE_PUBLIC(KFontAction)
@@ -50,11 +57,26 @@ public:
         //        qCDebug(KWidgetsAddonsLog) << "\tslotFontChanged done";
     }
 
+    void setComboBoxFont(QFontComboBox *cb, const QString &family)
+    {
+        cb->setCurrentFont(QFont(family.toLower()));
+
+        // QFontComboBox only maintains the selection in its own model,
+        // so select the entry in the shared model ourselves
+        int row = cb->findText(family, Qt::MatchFixedString);
+        if (row < 0) {
+            row = cb->findText(QFontInfo(QFont(family)).family(), Qt::MatchFixedString);
+        }
+        if (row >= 0) {
+            cb->setCurrentIndex(row);
+        }
+    }
+
     int settingFont = 0;
     QFontComboBox::FontFilters fontFilters = QFontComboBox::AllFonts;
 };
 
-QStringList fontList(const QFontComboBox::FontFilters &fontFilters = QFontComboBox::AllFonts)
+static QStringList createFontList(QFontComboBox::FontFilters fontFilters)
 {
     QStringList families;
     if (fontFilters == QFontComboBox::AllFonts) {
@@ -84,6 +106,60 @@ QStringList fontList(const QFontComboBox::FontFilters &fontFilters = QFontComboB
     return families;
 }
 
+// Font family lists and models shared by all font actions in the process,
+// one per set of font filters. Each created combobox would otherwise build
+// its own list of all families, with its own previews.
+class KFontActionFamilyCache
+{
+public:
+    KFontActionFamilyCache();
+
+    QStringList fontList(QFontComboBox::FontFilters fontFilters);
+    KFontFamilyModel *model(QFontComboBox::FontFilters fontFilters);
+
+private:
+    QHash<int, QStringList> m_fontLists;
+    std::map<int, std::unique_ptr<KFontFamilyModel>> m_models;
+};
+
+KFontActionFamilyCache::KFontActionFamilyCache()
+{
+    QObject::connect(qGuiApp, &QGuiApplication::fontDatabaseChanged, qGuiApp, [this]() {
+        m_fontLists.clear();
+        for (const auto &[key, model] : m_models) {
+            model->setFamilies(fontList(QFontComboBox::FontFilters(key)));
+        }
+    });
+}
+
+QStringList KFontActionFamilyCache::fontList(QFontComboBox::FontFilters fontFilters)
+{
+    const int key = fontFilters.toInt();
+    auto it = m_fontLists.constFind(key);
+    if (it == m_fontLists.cend()) {
+        it = m_fontLists.insert(key, createFontList(fontFilters));
+    }
+    return *it;
+}
+
+KFontFamilyModel *KFontActionFamilyCache::model(QFontComboBox::FontFilters fontFilters)
+{
+    const int key = fontFilters.toInt();
+    auto &model = m_models[key];
+    if (!model) {
+        model = std::make_unique<KFontFamilyModel>();
+        model->setFamilies(fontList(fontFilters));
+    }
+    return model.get();
+}
+
+Q_GLOBAL_STATIC(KFontActionFamilyCache, s_familyCache)
+
+static QStringList fontList(QFontComboBox::FontFilters fontFilters = QFontComboBox::AllFonts)
+{
+    return s_familyCache()->fontList(fontFilters);
+}
+
 KFontAction::KFontAction(uint fontListCriteria, QObject *parent)
     : KSelectAction(*new KFontActionPrivate(this), parent)
 {
@@ -142,11 +218,32 @@ QWidget *KFontAction::createWidget(QWidget *parent)
     // the KSelectAction one, preventing KSelectAction from creating its
     // regular KComboBox.
     QFontComboBox *cb = new QFontComboBox(parent);
+    // Share the family list and the previews with all other font actions.
+    // QFontComboBox leaves models other than its own alone, so set the
+    // filters only after replacing the model to not refill the old one.
+    KFontFamilyModel *model = s_familyCache()->model(d->fontFilters);
+    cb->setInsertPolicy(QComboBox::NoInsert);
+    cb->setModel(model);
     cb->setFontFilters(d->fontFilters);
+    auto *delegate = new KFontFamilyDelegate(cb);
+    delegate->setPreviewEnabled(true);
+    cb->setItemDelegate(delegate);
+
+    // On font database changes the combobox falls back to the first entry of
+    // the refilled model, do not report that as a selection by the user
+    connect(model, &QAbstractItemModel::modelAboutToBeReset, cb, [this]() {
+        Q_D(KFontAction);
+        d->settingFont++;
+    });
+    connect(model, &QAbstractItemModel::modelReset, cb, [this, cb]() {
+        Q_D(KFontAction);
+        d->setComboBoxFont(cb, font());
+        d->settingFont--;
+    });
 
     //    qCDebug(KWidgetsAddonsLog) << "\tset=" << font();
     // Do this before connecting the signal so that nothing will fire.
-    cb->setCurrentFont(QFont(font().toLower()));
+    d->setComboBoxFont(cb, font());
     //    qCDebug(KWidgetsAddonsLog) << "\tspit back=" << cb->currentFont().family();
 
     connect(cb, &QFontComboBox::currentFontChanged, this, [this](const QFont &ft) {
@@ -178,7 +275,7 @@ void KFontAction::setFont(const QString &family)
             continue;
         }
 
-        cb->setCurrentFont(QFont(family.toLower()));
+        d->setComboBoxFont(cb, family);
         //        qCDebug(KWidgetsAddonsLog) << "\t\tw spit back=" << cb->currentFont().family();
     }
 
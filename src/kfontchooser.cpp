@@ -8,6 +8,7 @@
 
 #include "kfontchooser.h"
 #include "fonthelpers_p.h"
+#include "kfontfamilymodel_p.h"
 #include "ui_kfontchooserwidget.h"
 
 #include "loggingcategory.h"
@@ -15,10 +16,13 @@
 #include <QCheckBox>
 #include <QDoubleSpinBox>
 #include <QFontDatabase>
+#include <QGlobalStatic>
 #include <QGroupBox>
 #include <QGuiApplication>
+#include <QHash>
 #include <QLabel>
 #include <QLayout>
+#include <QListView>
 #include <QListWidget>
 #include <QLocale>
 #include <QScrollBar>
@@ -28,31 +32,39 @@
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 // When message extraction needs to be avoided.
 #define TR_NOX tr
 
-static int minimumListWidth(const QListWidget *list)
+static int minimumListWidth(const QAbstractItemView *list, int maximumTextWidth)
 {
     QFontMetrics fm = list->fontMetrics();
 
+    // Add a space on both sides for a not too tight look.
     const int extraSpace = fm.horizontalAdvance(QLatin1Char(' ')) * 2;
 
     // Minimum initial size
-    int width = 40;
-    for (int i = 0, rows = list->count(); i < rows; ++i) {
-        int itemWidth = fm.horizontalAdvance(list->item(i)->text());
-        // ...and add a space on both sides for a not too tight look.
-        itemWidth += extraSpace;
-        width = std::max(width, itemWidth);
-    }
+    int width = std::max(40, maximumTextWidth + extraSpace);
 
     width += list->frameWidth() * 2;
     width += list->verticalScrollBar()->sizeHint().width();
     return width;
 }
 
-static int minimumListHeight(const QListWidget *list, int numVisibleEntry)
+static int minimumListWidth(const QListWidget *list)
+{
+    QFontMetrics fm = list->fontMetrics();
+
+    int maximumTextWidth = 0;
+    for (int i = 0, rows = list->count(); i < rows; ++i) {
+        maximumTextWidth = std::max(maximumTextWidth, fm.horizontalAdvance(list->item(i)->text()));
+    }
+
+    return minimumListWidth(list, maximumTextWidth);
+}
+
+static int minimumListHeight(const QAbstractItemView *list, int numVisibleEntry)
 {
     int w = list->fontMetrics().lineSpacing();
     if (w < 0) {
@@ -74,6 +86,145 @@ static QString formatFontSize(qreal size)
     return QLocale::system().toString(size, 'f', (size == floor(size)) ? 0 : 1);
 }
 
+static QString styleIdentifier(const QFont &font);
+
+static bool isDefaultFontStyleName(const QString &style)
+{
+    /* clang-format off */
+    // Ordered by commonness, i.e. "Regular" is the most common
+    return style == QLatin1String("Regular")
+        || style == QLatin1String("Normal")
+        || style == QLatin1String("Book")
+        || style == QLatin1String("Roman");
+    /* clang-format on */
+}
+
+// Results of the QFontDatabase queries done when a family or style gets
+// selected, shared by all chooser instances. Resolving a QFont for every
+// style of a family is expensive, and browsing the family list with the
+// keyboard would otherwise redo that work on every step.
+// All entries are dropped once the font database changes.
+class KFontChooserFontInfoCache
+{
+    Q_DECLARE_TR_FUNCTIONS(KFontChooser)
+
+public:
+    struct StyleInfo {
+        QString translatedStyle;
+        QString qtStyle;
+        QString styleId;
+    };
+
+    struct SizeInfo {
+        bool smoothlyScalable = false;
+        QList<qreal> sizes;
+    };
+
+    KFontChooserFontInfoCache();
+
+    const std::vector<StyleInfo> &styles(const QString &family);
+    const SizeInfo &sizes(const QString &family, const QString &style);
+
+private:
+    void checkGeneration();
+
+private:
+    quint64 m_generation = 0;
+    quint64 m_cachedGeneration = 0;
+    QHash<QString, std::vector<StyleInfo>> m_styles;
+    QHash<QString, SizeInfo> m_sizes;
+};
+
+KFontChooserFontInfoCache::KFontChooserFontInfoCache()
+{
+    QObject::connect(qGuiApp, &QGuiApplication::fontDatabaseChanged, qGuiApp, [this]() {
+        ++m_generation;
+    });
+}
+
+void KFontChooserFontInfoCache::checkGeneration()
+{
+    if (m_cachedGeneration != m_generation) {
+        m_styles.clear();
+        m_sizes.clear();
+        m_cachedGeneration = m_generation;
+    }
+}
+
+const std::vector<KFontChooserFontInfoCache::StyleInfo> &KFontChooserFontInfoCache::styles(const QString &family)
+{
+    checkGeneration();
+
+    auto it = m_styles.find(family);
+    if (it != m_styles.end()) {
+        return *it;
+    }
+
+    // Get the list of styles available in this family.
+    QStringList styles = QFontDatabase::styles(family);
+    if (styles.isEmpty()) {
+        // Avoid extraction, it is in kdeqt.po
+        styles.append(TR_NOX("Normal", "QFontDatabase"));
+    }
+
+    // Always prepend Regular, Normal, Book or Roman, this way if "m_selectedStyle"
+    // in the chooser is empty, selecting index 0 should work better
+    std::sort(styles.begin(), styles.end(), [](const QString &a, const QString &b) {
+        if (isDefaultFontStyleName(a)) {
+            return true;
+        } else if (isDefaultFontStyleName(b)) {
+            return false;
+        }
+        return false;
+    });
+
+    std::vector<StyleInfo> infos;
+    infos.reserve(styles.size());
+    for (const QString &style : std::as_const(styles)) {
+        // Sometimes the font database will report an invalid style,
+        // that falls back back to another when set.
+        // Remove such styles, by checking set/get round-trip.
+        QFont testFont = QFontDatabase::font(family, style, 10);
+        if (QFontDatabase::styleString(testFont) != style) {
+            continue;
+        }
+
+        const QString fstyle = tr("%1", "@item Font style").arg(style);
+        const bool known = std::any_of(infos.cbegin(), infos.cend(), [&fstyle](const StyleInfo &info) {
+            return info.translatedStyle == fstyle;
+        });
+        if (!known) {
+            infos.push_back({fstyle, style, styleIdentifier(testFont)});
+        }
+    }
+
+    return *m_styles.emplace(family, std::move(infos));
+}
+
+const KFontChooserFontInfoCache::SizeInfo &KFontChooserFontInfoCache::sizes(const QString &family, const QString &style)
+{
+    checkGeneration();
+
+    const QString key = family + QLatin1Char('\n') + style;
+    auto it = m_sizes.find(key);
+    if (it != m_sizes.end()) {
+        return *it;
+    }
+
+    SizeInfo info;
+    info.smoothlyScalable = QFontDatabase::isSmoothlyScalable(family, style);
+    if (!info.smoothlyScalable) {
+        const QList<int> smoothSizes = QFontDatabase::smoothSizes(family, style);
+        for (int size : smoothSizes) {
+            info.sizes.append(size);
+        }
+    }
+
+    return *m_sizes.emplace(key, std::move(info));
+}
+
+Q_GLOBAL_STATIC(KFontChooserFontInfoCache, s_fontInfoCache)
+
 class KFontChooserPrivate
 {
     Q_DECLARE_TR_FUNCTIONS(KFontChooser)
@@ -94,9 +245,11 @@ public:
     qreal setupSizeListBox(const QString &family, const QString &style);
 
     void setupDisplay();
-    QString styleIdentifier(const QFont &font);
 
-    void slotFamilySelected(const QString &);
+    QString currentQtFamily() const;
+    void setCurrentFamilyRow(int row);
+
+    void slotFamilySelected(const QModelIndex &index);
     void slotSizeSelected(const QString &);
     void slotStyleSelected(const QString &);
     void displaySample(const QFont &font);
@@ -106,6 +259,8 @@ public:
     KFontChooser *q;
 
     std::unique_ptr<Ui_KFontChooserWidget> m_ui;
+    KFontFamilyModel *m_familyModel = nullptr;
+    KFontFamilyDelegate *m_familyDelegate = nullptr;
 
     KFontChooser::DisplayFlags m_flags = KFontChooser::NoDisplayFlags;
 
@@ -122,8 +277,7 @@ public:
     bool m_signalsAllowed = true;
     bool m_usingFixed = false;
 
-    // Mappings of translated to Qt originated family and style strings.
-    FontFamiliesMap m_qtFamilies;
+    // Mapping of translated to Qt originated style strings.
     std::map<QString, QString> m_qtStyles;
     // Mapping of translated style strings to internal style identifiers.
     std::map<QString, QString> m_styleIDs;
@@ -175,14 +329,22 @@ void KFontChooserPrivate::init()
 
     const bool isDiffMode = m_flags & KFontChooser::ShowDifferences;
 
-    QObject::connect(m_ui->familyListWidget, &QListWidget::currentTextChanged, [this](const QString &family) {
-        slotFamilySelected(family);
+    // Font collections can be large, so the family list is a plain view on a flat model,
+    // with uniform item sizes to avoid querying the size of every single row.
+    m_familyModel = new KFontFamilyModel(q);
+    m_familyDelegate = new KFontFamilyDelegate(q);
+    m_ui->familyListView->setUniformItemSizes(true);
+    m_ui->familyListView->setModel(m_familyModel);
+    m_ui->familyListView->setItemDelegate(m_familyDelegate);
+
+    QObject::connect(m_ui->familyListView->selectionModel(), &QItemSelectionModel::currentChanged, [this](const QModelIndex &current) {
+        slotFamilySelected(current);
     });
 
     if (isDiffMode) {
         m_ui->familyLabel->hide();
-        m_ui->familyListWidget->setEnabled(false);
-        QObject::connect(m_ui->familyCheckBox, &QCheckBox::toggled, m_ui->familyListWidget, &QWidget::setEnabled);
+        m_ui->familyListView->setEnabled(false);
+        QObject::connect(m_ui->familyCheckBox, &QCheckBox::toggled, m_ui->familyListView, &QWidget::setEnabled);
     } else {
         m_ui->familyCheckBox->hide();
     }
@@ -337,7 +499,7 @@ QSize KFontChooser::sizeHint(void) const
 void KFontChooser::enableColumn(int column, bool state)
 {
     if (column & FamilyList) {
-        d->m_ui->familyListWidget->setEnabled(state);
+        d->m_ui->familyListView->setEnabled(state);
     }
     if (column & StyleList) {
         d->m_ui->styleListWidget->setEnabled(state);
@@ -387,76 +549,46 @@ QFont KFontChooser::font() const
     return d->m_selectedFont;
 }
 
-static bool isDefaultFontStyleName(const QString &style)
+void KFontChooser::setFamilyPreviewEnabled(bool enabled)
 {
-    /* clang-format off */
-    // Ordered by commonness, i.e. "Regular" is the most common
-    return style == QLatin1String("Regular")
-        || style == QLatin1String("Normal")
-        || style == QLatin1String("Book")
-        || style == QLatin1String("Roman");
-    /* clang-format on */
+    d->m_familyDelegate->setPreviewEnabled(enabled);
 }
 
-void KFontChooserPrivate::slotFamilySelected(const QString &family)
+bool KFontChooser::isFamilyPreviewEnabled() const
 {
-    if (!m_signalsAllowed) {
-        return;
-    }
-    m_signalsAllowed = false;
+    return d->m_familyDelegate->isPreviewEnabled();
+}
 
-    QString currentFamily;
-    if (family.isEmpty()) {
-        Q_ASSERT(m_ui->familyListWidget->currentItem());
-        if (m_ui->familyListWidget->currentItem()) {
-            currentFamily = m_qtFamilies[m_ui->familyListWidget->currentItem()->text()];
-        }
-    } else {
-        currentFamily = m_qtFamilies[family];
-    }
+QString KFontChooserPrivate::currentQtFamily() const
+{
+    return m_familyModel->rawFamily(m_ui->familyListView->currentIndex().row());
+}
 
-    // Get the list of styles available in this family.
-    QStringList styles = QFontDatabase::styles(currentFamily);
-    if (styles.isEmpty()) {
-        // Avoid extraction, it is in kdeqt.po
-        styles.append(TR_NOX("Normal", "QFontDatabase"));
+void KFontChooserPrivate::setCurrentFamilyRow(int row)
+{
+    m_ui->familyListView->setCurrentIndex(m_familyModel->index(row));
+}
+
+void KFontChooserPrivate::slotFamilySelected(const QModelIndex &index)
+{
+    if (!m_signalsAllowed || !index.isValid()) {
+        return;
     }
+    m_signalsAllowed = false;
 
-    // Always prepend Regular, Normal, Book or Roman, this way if "m_selectedStyle"
-    // in the code below is empty, selecting index 0 should work better
-    std::sort(styles.begin(), styles.end(), [](const QString &a, const QString &b) {
-        if (isDefaultFontStyleName(a)) {
-            return true;
-        } else if (isDefaultFontStyleName(b)) {
-            return false;
-        }
-        return false;
-    });
+    const QString currentFamily = m_familyModel->rawFamily(index.row());
 
     // Filter style strings and add to the listbox.
-    QString pureFamily;
-    splitFontString(family, &pureFamily);
     QStringList filteredStyles;
     m_qtStyles.clear();
     m_styleIDs.clear();
 
-    const QStringList origStyles = styles;
-    for (const QString &style : origStyles) {
-        // Sometimes the font database will report an invalid style,
-        // that falls back back to another when set.
-        // Remove such styles, by checking set/get round-trip.
-        QFont testFont = QFontDatabase::font(currentFamily, style, 10);
-        if (QFontDatabase::styleString(testFont) != style) {
-            styles.removeAll(style);
-            continue;
-        }
-
-        QString fstyle = tr("%1", "@item Font style").arg(style);
-        if (!filteredStyles.contains(fstyle)) {
-            filteredStyles.append(fstyle);
-            m_qtStyles.insert({fstyle, style});
-            m_styleIDs.insert({fstyle, styleIdentifier(testFont)});
-        }
+    const auto &styleInfos = s_fontInfoCache()->styles(currentFamily);
+    filteredStyles.reserve(styleInfos.size());
+    for (const auto &info : styleInfos) {
+        filteredStyles.append(info.translatedStyle);
+        m_qtStyles.insert({info.translatedStyle, info.qtStyle});
+        m_styleIDs.insert({info.translatedStyle, info.styleId});
     }
     m_ui->styleListWidget->clear();
     m_ui->styleListWidget->addItems(filteredStyles);
@@ -489,7 +621,7 @@ void KFontChooserPrivate::slotFamilySelected(const QString &family)
     m_ui->sizeSpinBox->setValue(currentSize);
 
     m_selectedFont = QFontDatabase::font(currentFamily, currentStyle, static_cast<int>(currentSize));
-    if (QFontDatabase::isSmoothlyScalable(currentFamily, currentStyle) && m_selectedFont.pointSize() == floor(currentSize)) {
+    if (s_fontInfoCache()->sizes(currentFamily, currentStyle).smoothlyScalable && m_selectedFont.pointSize() == floor(currentSize)) {
         m_selectedFont.setPointSizeF(currentSize);
     }
     Q_EMIT q->fontSelected(m_selectedFont);
@@ -504,7 +636,7 @@ void KFontChooserPrivate::slotStyleSelected(const QString &style)
     }
     m_signalsAllowed = false;
 
-    const QString currentFamily = m_qtFamilies[m_ui->familyListWidget->currentItem()->text()];
+    const QString currentFamily = currentQtFamily();
     const QString currentStyle = !style.isEmpty() ? m_qtStyles[style] : m_qtStyles[m_ui->styleListWidget->currentItem()->text()];
 
     // Recompute the size listbox for this family/style.
@@ -512,7 +644,7 @@ void KFontChooserPrivate::slotStyleSelected(const QString &style)
     m_ui->sizeSpinBox->setValue(currentSize);
 
     m_selectedFont = QFontDatabase::font(currentFamily, currentStyle, static_cast<int>(currentSize));
-    if (QFontDatabase::isSmoothlyScalable(currentFamily, currentStyle) && m_selectedFont.pointSize() == floor(currentSize)) {
+    if (s_fontInfoCache()->sizes(currentFamily, currentStyle).smoothlyScalable && m_selectedFont.pointSize() == floor(currentSize)) {
         m_selectedFont.setPointSizeF(currentSize);
     }
     Q_EMIT q->fontSelected(m_selectedFont);
@@ -574,11 +706,11 @@ void KFontChooserPrivate::slotSizeValue(double dval)
 
     bool canCustomize = true;
 
-    const QString family = m_qtFamilies[m_ui->familyListWidget->currentItem()->text()];
+    const QString family = currentQtFamily();
     const QString style = m_qtStyles[m_ui->styleListWidget->currentItem()->text()];
 
     // For Qt-bad-sizes workaround: skip this block unconditionally
-    if (!QFontDatabase::isSmoothlyScalable(family, style)) {
+    if (!s_fontInfoCache()->sizes(family, style).smoothlyScalable) {
         // Bitmap font, allow only discrete sizes.
         // Determine the nearest in the direction of change.
         canCustomize = false;
@@ -712,18 +844,9 @@ qreal KFontChooserPrivate::fillSizeList(const QList<qreal> &sizes_)
 
 qreal KFontChooserPrivate::setupSizeListBox(const QString &family, const QString &style)
 {
-    QList<qreal> sizes;
-    const bool smoothlyScalable = QFontDatabase::isSmoothlyScalable(family, style);
-    if (!smoothlyScalable) {
-        const QList<int> smoothSizes = QFontDatabase::smoothSizes(family, style);
-        for (int size : smoothSizes) {
-            sizes.append(size);
-        }
-    }
-
     // Fill the listbox (uses default list of sizes if the given is empty).
     // Collect the best fitting size to selected size, to use if not smooth.
-    qreal bestFitSize = fillSizeList(sizes);
+    qreal bestFitSize = fillSizeList(s_fontInfoCache()->sizes(family, style).sizes);
 
     // Set the best fit size as current in the listbox if available.
     const QList<QListWidgetItem *> selectedSizeList = m_ui->sizeListWidget->findItems(formatFontSize(bestFitSize), Qt::MatchExactly);
@@ -758,16 +881,16 @@ void KFontChooserPrivate::setupDisplay()
     int numEntries;
     int i;
 
-    // Get the styleID here before familyListWidget->setCurrentRow() is called
+    // Get the styleID here before setCurrentFamilyRow() is called
     // as it may change the font style
     const QString styleID = styleIdentifier(m_selectedFont);
 
     QString family = m_selectedFont.family().toLower();
     // Direct family match.
-    numEntries = m_ui->familyListWidget->count();
+    numEntries = m_familyModel->rowCount();
     for (i = 0; i < numEntries; ++i) {
-        if (family == m_qtFamilies[m_ui->familyListWidget->item(i)->text()].toLower()) {
-            m_ui->familyListWidget->setCurrentRow(i);
+        if (family == m_familyModel->rawFamily(i).toLower()) {
+            setCurrentFamilyRow(i);
             break;
         }
     }
@@ -778,8 +901,8 @@ void KFontChooserPrivate::setupDisplay()
         if (bracketPos != -1) {
             family = QStringView(family).left(bracketPos).trimmed().toString();
             for (i = 0; i < numEntries; ++i) {
-                if (family == m_qtFamilies[m_ui->familyListWidget->item(i)->text()].toLower()) {
-                    m_ui->familyListWidget->setCurrentRow(i);
+                if (family == m_familyModel->rawFamily(i).toLower()) {
+                    setCurrentFamilyRow(i);
                     break;
                 }
             }
@@ -790,8 +913,8 @@ void KFontChooserPrivate::setupDisplay()
     if (i == numEntries) {
         QString fallback = family + QLatin1String(" [");
         for (i = 0; i < numEntries; ++i) {
-            if (m_qtFamilies[m_ui->familyListWidget->item(i)->text()].toLower().startsWith(fallback)) {
-                m_ui->familyListWidget->setCurrentRow(i);
+            if (m_familyModel->rawFamily(i).toLower().startsWith(fallback)) {
+                setCurrentFamilyRow(i);
                 break;
             }
         }
@@ -800,8 +923,8 @@ void KFontChooserPrivate::setupDisplay()
     // 3rd family fallback.
     if (i == numEntries) {
         for (i = 0; i < numEntries; ++i) {
-            if (m_qtFamilies[m_ui->familyListWidget->item(i)->text()].toLower().startsWith(family)) {
-                m_ui->familyListWidget->setCurrentRow(i);
+            if (m_familyModel->rawFamily(i).toLower().startsWith(family)) {
+                setCurrentFamilyRow(i);
                 break;
             }
         }
@@ -809,7 +932,7 @@ void KFontChooserPrivate::setupDisplay()
 
     // Family fallback in case nothing matched. Otherwise, diff doesn't work
     if (i == numEntries) {
-        m_ui->familyListWidget->setCurrentRow(0);
+        setCurrentFamilyRow(0);
     }
 
     // By setting the current item in the family box, the available
@@ -832,9 +955,9 @@ void KFontChooserPrivate::setupDisplay()
     // Set current size in the listbox.
     // If smoothly scalable, allow customizing one of the standard size slots,
     // otherwise just select the nearest available size.
-    const QString currentFamily = m_qtFamilies[m_ui->familyListWidget->currentItem()->text()];
+    const QString currentFamily = currentQtFamily();
     const QString currentStyle = m_qtStyles[m_ui->styleListWidget->currentItem()->text()];
-    const bool canCustomize = QFontDatabase::isSmoothlyScalable(currentFamily, currentStyle);
+    const bool canCustomize = s_fontInfoCache()->sizes(currentFamily, currentStyle).smoothlyScalable;
     m_ui->sizeListWidget->setCurrentRow(nearestSizeRow(size, canCustomize));
 
     // Set current size in the spinbox.
@@ -887,12 +1010,14 @@ void KFontChooserPrivate::setFamilyBoxItems(const QStringList &fonts)
 {
     m_signalsAllowed = false;
 
-    m_ui->familyListWidget->clear();
-
-    m_qtFamilies = translateFontNameList(!fonts.isEmpty() ? fonts : KFontChooser::createFontList(m_usingFixed ? KFontChooser::FixedWidthFonts : 0));
+    // Mapping of translated to Qt originated family strings.
+    const FontFamiliesMap qtFamilies =
+        translateFontNameList(!fonts.isEmpty() ? fonts : KFontChooser::createFontList(m_usingFixed ? KFontChooser::FixedWidthFonts : 0));
 
     QStringList list;
-    list.reserve(m_qtFamilies.size());
+    QStringList qtList;
+    list.reserve(qtFamilies.size());
+    qtList.reserve(qtFamilies.size());
 
     // Generic font names
     const QStringList genericTranslatedNames{
@@ -903,30 +1028,34 @@ void KFontChooserPrivate::setFamilyBoxItems(const QStringList &fonts)
 
     // Add generic family names to the top of the list
     for (const QString &s : genericTranslatedNames) {
-        auto nIt = m_qtFamilies.find(s);
-        if (nIt != m_qtFamilies.cend()) {
+        auto nIt = qtFamilies.find(s);
+        if (nIt != qtFamilies.cend()) {
             list.push_back(s);
+            qtList.push_back(nIt->second);
         }
     }
 
-    for (auto it = m_qtFamilies.cbegin(); it != m_qtFamilies.cend(); ++it) {
+    for (auto it = qtFamilies.cbegin(); it != qtFamilies.cend(); ++it) {
         const QString &name = it->first;
         if (genericTranslatedNames.contains(name)) {
             continue;
         }
 
         list.push_back(name);
+        qtList.push_back(it->second);
     }
 
-    m_ui->familyListWidget->addItems(list);
-    m_ui->familyListWidget->setMinimumWidth(minimumListWidth(m_ui->familyListWidget));
+    m_familyModel->setFamilies(list, qtList);
+    const int maximumTextWidth = m_familyModel->estimatedMaximumTextWidth(m_ui->familyListView->fontMetrics());
+    m_ui->familyListView->setMinimumWidth(minimumListWidth(m_ui->familyListView, maximumTextWidth));
 
     m_signalsAllowed = true;
 }
 
 void KFontChooser::setMinVisibleItems(int visibleItems)
 {
-    for (auto *widget : {d->m_ui->familyListWidget, d->m_ui->styleListWidget, d->m_ui->sizeListWidget}) {
+    const QList<QAbstractItemView *> views{d->m_ui->familyListView, d->m_ui->styleListWidget, d->m_ui->sizeListWidget};
+    for (auto *widget : views) {
         widget->setMinimumHeight(minimumListHeight(widget, visibleItems));
     }
 }
@@ -937,7 +1066,7 @@ void KFontChooser::setMinVisibleItems(int visibleItems)
 // the chooser dialog is opened. This will cause the style to be changed
 // when the dialog is closed and the user did not touch the style box.
 // Hence, construct custom style identifiers sufficient for the purpose.
-QString KFontChooserPrivate::styleIdentifier(const QFont &font)
+static QString styleIdentifier(const QFont &font)
 {
     const int weight = font.weight();
     QString styleName = font.styleName();
@@ -249,6 +249,28 @@ public:
      */
     void setMinVisibleItems(int visibleItems);
 
+    /*!
+     * Sets whether each entry in the font family list is shown
+     * rendered in the font of that family.
+     *
+     * The previews are only rendered for the entries scrolled into view.
+     *
+     * Disabled by default.
+     *
+     * \sa isFamilyPreviewEnabled()
+     * \since 6.30
+     */
+    void setFamilyPreviewEnabled(bool enabled);
+
+    /*!
+     * Returns whether the entries in the font family list are
+     * rendered in the font of the respective family.
+     *
+     * \sa setFamilyPreviewEnabled()
+     * \since 6.30
+     */
+    bool isFamilyPreviewEnabled() const;
+
     QSize sizeHint(void) const override;
 
 Q_SIGNALS:
@@ -0,0 +1,230 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kfontfamilymodel_p.h"
+
+#include <QApplication>
+#include <QCache>
+#include <QFontDatabase>
+#include <QFontMetricsF>
+#include <QGlobalStatic>
+#include <QPainter>
+#include <QPixmap>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+KFontFamilyModel::KFontFamilyModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+void KFontFamilyModel::setFamilies(const QStringList &displayNames, const QStringList &rawFamilies)
+{
+    Q_ASSERT(rawFamilies.isEmpty() || rawFamilies.size() == displayNames.size());
+
+    beginResetModel();
+    m_displayNames = displayNames;
+    m_rawFamilies = rawFamilies.isEmpty() ? displayNames : rawFamilies;
+    endResetModel();
+}
+
+QString KFontFamilyModel::displayName(int row) const
+{
+    return m_displayNames.value(row);
+}
+
+QString KFontFamilyModel::rawFamily(int row) const
+{
+    return m_rawFamilies.value(row);
+}
+
+int KFontFamilyModel::estimatedMaximumTextWidth(const QFontMetrics &fm) const
+{
+    // Number of entries actually measured
+    constexpr std::size_t sampleCount = 32;
+
+    std::vector<int> rows(m_displayNames.size());
+    std::iota(rows.begin(), rows.end(), 0);
+    const std::size_t measuredCount = std::min(sampleCount, rows.size());
+    std::partial_sort(rows.begin(), rows.begin() + measuredCount, rows.end(), [this](int a, int b) {
+        return m_displayNames.at(a).size() > m_displayNames.at(b).size();
+    });
+
+    int width = 0;
+    for (std::size_t i = 0; i < measuredCount; ++i) {
+        width = std::max(width, fm.horizontalAdvance(m_displayNames.at(rows[i])));
+    }
+    return width;
+}
+
+int KFontFamilyModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_displayNames.size();
+}
+
+QVariant KFontFamilyModel::data(const QModelIndex &index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+        return {};
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+    case Qt::ToolTipRole:
+        return m_displayNames.at(index.row());
+    case RawFamilyRole:
+        return m_rawFamilies.at(index.row());
+    default:
+        return {};
+    }
+}
+
+// Cache of the rendered family previews, shared by all delegates.
+// Bounded in size, so browsing through a large font collection
+// only keeps the recently painted previews around.
+class KFontFamilyPreviewCache
+{
+public:
+    KFontFamilyPreviewCache();
+
+    QPixmap preview(const QString &family, const QString &text, const QFont &baseFont, const QColor &color, qreal dpr);
+
+private:
+    QCache<QString, QPixmap> m_pixmaps;
+};
+
+KFontFamilyPreviewCache::KFontFamilyPreviewCache()
+{
+    // in KiB
+    m_pixmaps.setMaxCost(8 * 1024);
+
+    QObject::connect(qGuiApp, &QGuiApplication::fontDatabaseChanged, qGuiApp, [this]() {
+        m_pixmaps.clear();
+    });
+}
+
+QPixmap KFontFamilyPreviewCache::preview(const QString &family, const QString &text, const QFont &baseFont, const QColor &color, qreal dpr)
+{
+    const QChar separator(QLatin1Char('\n'));
+    const QString key = family + separator + text + separator //
+        + QString::number(baseFont.pointSizeF()) + separator //
+        + QString::number(baseFont.pixelSize()) + separator //
+        + QString::number(color.rgba()) + separator //
+        + QString::number(dpr);
+
+    if (const QPixmap *pixmap = m_pixmaps.object(key)) {
+        return *pixmap;
+    }
+
+    // Symbol fonts would render the name unreadable, show them in the normal font
+    QFont font = baseFont;
+    if (!QFontDatabase::writingSystems(family).contains(QFontDatabase::Symbol)) {
+        font.setFamilies({family});
+        font.setStyleName(QString());
+    }
+
+    const QFontMetricsF fm(font);
+    const QSizeF size(fm.horizontalAdvance(text), fm.height());
+    if (size.isEmpty()) {
+        return QPixmap();
+    }
+
+    auto *pixmap = new QPixmap((size * dpr).toSize());
+    pixmap->setDevicePixelRatio(dpr);
+    pixmap->fill(Qt::transparent);
+
+    QPainter painter(pixmap);
+    painter.setFont(font);
+    painter.setPen(color);
+    painter.drawText(QRectF(QPointF(0, 0), size), Qt::AlignLeft | Qt::AlignVCenter | Qt::TextSingleLine, text);
+    painter.end();
+
+    const QPixmap result = *pixmap;
+    const int cost = std::max(1, pixmap->width() * pixmap->height() * 4 / 1024);
+    m_pixmaps.insert(key, pixmap, cost);
+    return result;
+}
+
+Q_GLOBAL_STATIC(KFontFamilyPreviewCache, s_previewCache)
+
+KFontFamilyDelegate::KFontFamilyDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+void KFontFamilyDelegate::setPreviewEnabled(bool enabled)
+{
+    if (m_previewEnabled == enabled) {
+        return;
+    }
+    m_previewEnabled = enabled;
+    // Relayout the views, the row height differs with previews
+    Q_EMIT sizeHintChanged(QModelIndex());
+}
+
+bool KFontFamilyDelegate::isPreviewEnabled() const
+{
+    return m_previewEnabled;
+}
+
+void KFontFamilyDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    if (!m_previewEnabled) {
+        QStyledItemDelegate::paint(painter, option, index);
+        return;
+    }
+
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+    const QString text = opt.text;
+    opt.text.clear();
+
+    // Let the style draw background, selection and focus, then put the preview on top
+    const QWidget *widget = opt.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+    style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+    const QRect textRect = style->subElementRect(QStyle::SE_ItemViewItemText, &opt, widget);
+    QPalette::ColorGroup colorGroup = QPalette::Normal;
+    if (!(opt.state & QStyle::State_Enabled)) {
+        colorGroup = QPalette::Disabled;
+    } else if (!(opt.state & QStyle::State_Active)) {
+        colorGroup = QPalette::Inactive;
+    }
+    const QPalette::ColorRole colorRole = (opt.state & QStyle::State_Selected) ? QPalette::HighlightedText : QPalette::Text;
+    const QString family = index.data(KFontFamilyModel::RawFamilyRole).toString();
+    const qreal dpr = painter->device() ? painter->device()->devicePixelRatio() : qApp->devicePixelRatio();
+
+    const QPixmap pixmap = s_previewCache()->preview(family, text, opt.font, opt.palette.color(colorGroup, colorRole), dpr);
+    if (pixmap.isNull()) {
+        return;
+    }
+
+    const QSizeF pixmapSize = pixmap.deviceIndependentSize();
+    const QPointF topLeft(opt.direction == Qt::RightToLeft ? textRect.right() + 1 - pixmapSize.width() : textRect.left(),
+                          textRect.top() + (textRect.height() - pixmapSize.height()) / 2);
+
+    painter->save();
+    painter->setClipRect(textRect);
+    painter->drawPixmap(topLeft, pixmap);
+    painter->restore();
+}
+
+QSize KFontFamilyDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    QSize size = QStyledItemDelegate::sizeHint(option, index);
+    if (m_previewEnabled) {
+        // Leave room for fonts with larger metrics than the one of the view
+        size.setHeight(std::max(size.height(), option.fontMetrics.height() * 3 / 2));
+    }
+    return size;
+}
+
+#include "moc_kfontfamilymodel_p.cpp"
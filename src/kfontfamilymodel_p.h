@@ -0,0 +1,89 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KFONTFAMILYMODEL_P_H
+#define KFONTFAMILYMODEL_P_H
+
+#include <QAbstractListModel>
+#include <QStringList>
+#include <QStyledItemDelegate>
+
+class QFontMetrics;
+
+/*!
+ * \internal
+ *
+ * Flat list model of font families, as shown in the font selection widgets.
+ *
+ * The display role holds the (translated) name presented to the user,
+ * RawFamilyRole the family name as known to QFontDatabase.
+ */
+class KFontFamilyModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        RawFamilyRole = Qt::UserRole + 1,
+    };
+
+    explicit KFontFamilyModel(QObject *parent = nullptr);
+
+    /*!
+     * Replaces the content of the model. Both lists need to have the same size,
+     * \a rawFamilies defaults to \a displayNames if empty.
+     */
+    void setFamilies(const QStringList &displayNames, const QStringList &rawFamilies = {});
+
+    QString displayName(int row) const;
+    QString rawFamily(int row) const;
+
+    /*!
+     * Returns an estimate for the width needed to show all display names with \a fm.
+     *
+     * Instead of measuring every entry only the longest ones by character count
+     * are measured, which is good enough for sizing a view and stays cheap
+     * even with thousands of families.
+     */
+    int estimatedMaximumTextWidth(const QFontMetrics &fm) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    QStringList m_displayNames;
+    QStringList m_rawFamilies;
+};
+
+/*!
+ * \internal
+ *
+ * Item delegate for views on a KFontFamilyModel which optionally
+ * renders each family name in the font of that family.
+ *
+ * The previews are rendered on demand, so only for the rows actually
+ * painted, and are kept in a size-bounded cache shared by all delegates.
+ * Views using this delegate should enable QListView::uniformItemSizes.
+ */
+class KFontFamilyDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit KFontFamilyDelegate(QObject *parent = nullptr);
+
+    void setPreviewEnabled(bool enabled);
+    bool isPreviewEnabled() const;
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+private:
+    bool m_previewEnabled = false;
+};
+
+#endif
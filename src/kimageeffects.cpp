@@ -0,0 +1,417 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kimageeffects_p.h"
+
+#include <QtEndian>
+
+#include <algorithm>
+#include <cmath>
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KIMAGEEFFECTS_SSE2
+#include <emmintrin.h>
+#endif
+// AVX2 is not part of the baseline, so its code is built for it separately and only used if supported
+#if defined(KIMAGEEFFECTS_SSE2) && (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER) && (defined(__x86_64__) || defined(__i386__))
+#define KIMAGEEFFECTS_AVX2
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define KIMAGEEFFECTS_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace
+{
+// Per channel linear function, out = (in * mul + add) >> 8.
+// Indexed by the position of the channel in the pixel value, i.e. blue, green, red, alpha.
+// mul must be at most 256 and in * mul + add must stay below 65536.
+struct LinearFactors {
+    quint16 mul[4];
+    quint16 add[4];
+};
+
+using LinearKernel = void (*)(quint32 *pixels, qsizetype count, const LinearFactors &factors);
+using DesaturateKernel = void (*)(quint32 *pixels, qsizetype count, quint32 value);
+
+void linearGeneric(quint32 *pixels, qsizetype count, const LinearFactors &factors)
+{
+    for (qsizetype i = 0; i < count; ++i) {
+        const quint32 pixel = pixels[i];
+        quint32 result = 0;
+        for (int channel = 0; channel < 4; ++channel) {
+            const quint32 value = (pixel >> (channel * 8)) & 0xff;
+            result |= ((value * factors.mul[channel] + factors.add[channel]) >> 8) << (channel * 8);
+        }
+        pixels[i] = result;
+    }
+}
+
+void desaturateGeneric(quint32 *pixels, qsizetype count, quint32 value)
+{
+    const quint32 inverseValue = 255 - value;
+    for (qsizetype i = 0; i < count; ++i) {
+        const quint32 pixel = pixels[i];
+        const quint32 red = (pixel >> 16) & 0xff;
+        const quint32 green = (pixel >> 8) & 0xff;
+        const quint32 blue = pixel & 0xff;
+        // Same as qGray()
+        const quint32 gray = (red * 11 + green * 16 + blue * 5) / 32;
+        const quint32 grayPart = value * gray;
+        pixels[i] = (pixel & 0xff000000) //
+            | (((grayPart + inverseValue * red) >> 8) << 16) //
+            | (((grayPart + inverseValue * green) >> 8) << 8) //
+            | ((grayPart + inverseValue * blue) >> 8);
+    }
+}
+
+#ifdef KIMAGEEFFECTS_SSE2
+void linearSse2(quint32 *pixels, qsizetype count, const LinearFactors &factors)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mul = _mm_setr_epi16(factors.mul[0], factors.mul[1], factors.mul[2], factors.mul[3], //
+                                       factors.mul[0], factors.mul[1], factors.mul[2], factors.mul[3]);
+    const __m128i add = _mm_setr_epi16(factors.add[0], factors.add[1], factors.add[2], factors.add[3], //
+                                       factors.add[0], factors.add[1], factors.add[2], factors.add[3]);
+
+    qsizetype i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+        __m128i low = _mm_unpacklo_epi8(pixel, zero);
+        __m128i high = _mm_unpackhi_epi8(pixel, zero);
+        low = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(low, mul), add), 8);
+        high = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(high, mul), add), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pixels + i), _mm_packus_epi16(low, high));
+    }
+    linearGeneric(pixels + i, count - i, factors);
+}
+
+// Two pixels with 16 bit channels
+inline __m128i desaturateChannelsSse2(__m128i channels, __m128i value, __m128i inverseValue)
+{
+    const __m128i weights = _mm_setr_epi16(5, 16, 11, 0, 5, 16, 11, 0);
+    const __m128i alphaMask = _mm_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1);
+
+    // Blue and green, red and alpha summed up in 32 bit, then all of them in the lower 32 bit of each pixel
+    __m128i gray = _mm_madd_epi16(channels, weights);
+    gray = _mm_add_epi32(gray, _mm_srli_epi64(gray, 32));
+    gray = _mm_srli_epi32(gray, 5);
+    gray = _mm_shufflehi_epi16(_mm_shufflelo_epi16(gray, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+
+    const __m128i result = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(gray, value), _mm_mullo_epi16(channels, inverseValue)), 8);
+    return _mm_or_si128(_mm_andnot_si128(alphaMask, result), _mm_and_si128(alphaMask, channels));
+}
+
+void desaturateSse2(quint32 *pixels, qsizetype count, quint32 value)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i valueVector = _mm_set1_epi16(short(value));
+    const __m128i inverseValueVector = _mm_set1_epi16(short(255 - value));
+
+    qsizetype i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + i));
+        const __m128i low = desaturateChannelsSse2(_mm_unpacklo_epi8(pixel, zero), valueVector, inverseValueVector);
+        const __m128i high = desaturateChannelsSse2(_mm_unpackhi_epi8(pixel, zero), valueVector, inverseValueVector);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pixels + i), _mm_packus_epi16(low, high));
+    }
+    desaturateGeneric(pixels + i, count - i, value);
+}
+#endif
+
+#ifdef KIMAGEEFFECTS_AVX2
+// Same as the SSE2 variants, but on two 128 bit lanes at once
+__attribute__((target("avx2"))) void linearAvx2(quint32 *pixels, qsizetype count, const LinearFactors &factors)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i mul = _mm256_setr_epi16(factors.mul[0], factors.mul[1], factors.mul[2], factors.mul[3], //
+                                          factors.mul[0], factors.mul[1], factors.mul[2], factors.mul[3], //
+                                          factors.mul[0], factors.mul[1], factors.mul[2], factors.mul[3], //
+                                          factors.mul[0], factors.mul[1], factors.mul[2], factors.mul[3]);
+    const __m256i add = _mm256_setr_epi16(factors.add[0], factors.add[1], factors.add[2], factors.add[3], //
+                                          factors.add[0], factors.add[1], factors.add[2], factors.add[3], //
+                                          factors.add[0], factors.add[1], factors.add[2], factors.add[3], //
+                                          factors.add[0], factors.add[1], factors.add[2], factors.add[3]);
+
+    qsizetype i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i pixel = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i));
+        __m256i low = _mm256_unpacklo_epi8(pixel, zero);
+        __m256i high = _mm256_unpackhi_epi8(pixel, zero);
+        low = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(low, mul), add), 8);
+        high = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(high, mul), add), 8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pixels + i), _mm256_packus_epi16(low, high));
+    }
+    linearSse2(pixels + i, count - i, factors);
+}
+
+__attribute__((target("avx2"))) inline __m256i desaturateChannelsAvx2(__m256i channels, __m256i value, __m256i inverseValue)
+{
+    const __m256i weights = _mm256_setr_epi16(5, 16, 11, 0, 5, 16, 11, 0, 5, 16, 11, 0, 5, 16, 11, 0);
+    const __m256i alphaMask = _mm256_setr_epi16(0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1);
+
+    __m256i gray = _mm256_madd_epi16(channels, weights);
+    gray = _mm256_add_epi32(gray, _mm256_srli_epi64(gray, 32));
+    gray = _mm256_srli_epi32(gray, 5);
+    gray = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(gray, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+
+    const __m256i result = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(gray, value), _mm256_mullo_epi16(channels, inverseValue)), 8);
+    return _mm256_or_si256(_mm256_andnot_si256(alphaMask, result), _mm256_and_si256(alphaMask, channels));
+}
+
+__attribute__((target("avx2"))) void desaturateAvx2(quint32 *pixels, qsizetype count, quint32 value)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i valueVector = _mm256_set1_epi16(short(value));
+    const __m256i inverseValueVector = _mm256_set1_epi16(short(255 - value));
+
+    qsizetype i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i pixel = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pixels + i));
+        const __m256i low = desaturateChannelsAvx2(_mm256_unpacklo_epi8(pixel, zero), valueVector, inverseValueVector);
+        const __m256i high = desaturateChannelsAvx2(_mm256_unpackhi_epi8(pixel, zero), valueVector, inverseValueVector);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pixels + i), _mm256_packus_epi16(low, high));
+    }
+    desaturateSse2(pixels + i, count - i, value);
+}
+
+bool hasAvx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+#ifdef KIMAGEEFFECTS_NEON
+void linearNeon(quint32 *pixels, qsizetype count, const LinearFactors &factors)
+{
+    qsizetype i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint8_t *data = reinterpret_cast<uint8_t *>(pixels + i);
+        // Deinterleaved, one register per channel
+        uint8x8x4_t channels = vld4_u8(data);
+        for (int channel = 0; channel < 4; ++channel) {
+            const uint16x8_t result = vmlaq_u16(vdupq_n_u16(factors.add[channel]), vmovl_u8(channels.val[channel]), vdupq_n_u16(factors.mul[channel]));
+            channels.val[channel] = vshrn_n_u16(result, 8);
+        }
+        vst4_u8(data, channels);
+    }
+    linearGeneric(pixels + i, count - i, factors);
+}
+
+void desaturateNeon(quint32 *pixels, qsizetype count, quint32 value)
+{
+    const uint8x8_t valueVector = vdup_n_u8(uint8_t(value));
+    const uint8x8_t inverseValueVector = vdup_n_u8(uint8_t(255 - value));
+
+    qsizetype i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint8_t *data = reinterpret_cast<uint8_t *>(pixels + i);
+        uint8x8x4_t channels = vld4_u8(data);
+        uint16x8_t sum = vmull_u8(channels.val[2], vdup_n_u8(11));
+        sum = vmlal_u8(sum, channels.val[1], vdup_n_u8(16));
+        sum = vmlal_u8(sum, channels.val[0], vdup_n_u8(5));
+        const uint16x8_t grayPart = vmull_u8(vshrn_n_u16(sum, 5), valueVector);
+        for (int channel = 0; channel < 3; ++channel) {
+            channels.val[channel] = vshrn_n_u16(vmlal_u8(grayPart, channels.val[channel], inverseValueVector), 8);
+        }
+        vst4_u8(data, channels);
+    }
+    desaturateGeneric(pixels + i, count - i, value);
+}
+#endif
+
+struct Kernels {
+    KImageEffects::Implementation implementation;
+    LinearKernel linear;
+    DesaturateKernel desaturate;
+};
+
+Kernels kernels(KImageEffects::Implementation implementation)
+{
+    switch (implementation) {
+#ifdef KIMAGEEFFECTS_SSE2
+    case KImageEffects::Implementation::Sse2:
+        return {implementation, linearSse2, desaturateSse2};
+#endif
+#ifdef KIMAGEEFFECTS_AVX2
+    case KImageEffects::Implementation::Avx2:
+        return {implementation, linearAvx2, desaturateAvx2};
+#endif
+#ifdef KIMAGEEFFECTS_NEON
+    case KImageEffects::Implementation::Neon:
+        return {implementation, linearNeon, desaturateNeon};
+#endif
+    default:
+        return {KImageEffects::Implementation::Generic, linearGeneric, desaturateGeneric};
+    }
+}
+
+Kernels &currentKernels()
+{
+    static Kernels current = kernels(KImageEffects::availableImplementations().constLast());
+    return current;
+}
+
+// Calls kernel on the pixels of image, which has to have a 32 bit format
+template<typename Kernel, typename... Args>
+void forEachScanLine(QImage &image, Kernel kernel, const Args &...args)
+{
+    const int width = image.width();
+    if (image.bytesPerLine() == width * 4) {
+        kernel(reinterpret_cast<quint32 *>(image.bits()), qsizetype(width) * image.height(), args...);
+        return;
+    }
+    for (int y = 0; y < image.height(); ++y) {
+        kernel(reinterpret_cast<quint32 *>(image.scanLine(y)), width, args...);
+    }
+}
+
+// Converts image to a 32 bit format, if it is not already. Returns the format to convert back to afterwards.
+QImage::Format ensureArgb32(QImage &image, bool allowPremultiplied)
+{
+    const QImage::Format format = image.format();
+    switch (format) {
+    case QImage::Format_ARGB32:
+        return format;
+    case QImage::Format_RGB32:
+    case QImage::Format_ARGB32_Premultiplied:
+        if (allowPremultiplied) {
+            return format;
+        }
+        break;
+    default:
+        break;
+    }
+    image.convertTo(QImage::Format_ARGB32);
+    return format;
+}
+
+void restoreFormat(QImage &image, QImage::Format format)
+{
+    if (image.format() != format) {
+        image.convertTo(format);
+    }
+}
+
+// Fixed point factor with 8 fractional bits
+quint16 fixedPoint(float factor)
+{
+    return quint16(std::lround(std::clamp(factor, 0.0f, 1.0f) * 256));
+}
+}
+
+namespace KImageEffects
+{
+QList<Implementation> availableImplementations()
+{
+    QList<Implementation> implementations{Implementation::Generic};
+#ifdef KIMAGEEFFECTS_SSE2
+    implementations.append(Implementation::Sse2);
+#endif
+#ifdef KIMAGEEFFECTS_AVX2
+    if (hasAvx2()) {
+        implementations.append(Implementation::Avx2);
+    }
+#endif
+#ifdef KIMAGEEFFECTS_NEON
+    implementations.append(Implementation::Neon);
+#endif
+    return implementations;
+}
+
+Implementation implementation()
+{
+    return currentKernels().implementation;
+}
+
+bool setImplementation(Implementation implementation)
+{
+    if (!availableImplementations().contains(implementation)) {
+        return false;
+    }
+    currentKernels() = kernels(implementation);
+    return true;
+}
+
+void desaturate(QImage &image, float amount)
+{
+    if (image.isNull()) {
+        return;
+    }
+    // Linear in each channel, so premultiplied colors work as well
+    const QImage::Format format = ensureArgb32(image, true);
+    const quint32 value = quint32(255.0f * std::clamp(amount, 0.0f, 1.0f));
+    forEachScanLine(image, currentKernels().desaturate, value);
+    restoreFormat(image, format);
+}
+
+void scaleAlpha(QImage &image, float factor)
+{
+    if (image.isNull()) {
+        return;
+    }
+    // Without an alpha channel there is nothing to scale
+    if (image.format() == QImage::Format_RGB32) {
+        image.convertTo(QImage::Format_ARGB32);
+    }
+    const QImage::Format format = ensureArgb32(image, true);
+
+    // With premultiplied alpha the colors need to be scaled as well
+    const quint16 alpha = fixedPoint(factor);
+    const quint16 color = image.format() == QImage::Format_ARGB32_Premultiplied ? alpha : 256;
+    const LinearFactors factors{{color, color, color, alpha}, {0, 0, 0, 0}};
+    forEachScanLine(image, currentKernels().linear, factors);
+    restoreFormat(image, format);
+}
+
+void tint(QImage &image, const QColor &color, float amount)
+{
+    if (image.isNull()) {
+        return;
+    }
+    const QImage::Format format = ensureArgb32(image, false);
+
+    const quint16 tintPart = fixedPoint(amount);
+    const quint16 imagePart = 256 - tintPart;
+    const QRgb rgb = color.rgb();
+    const LinearFactors factors{{imagePart, imagePart, imagePart, 256},
+                                {quint16(qBlue(rgb) * tintPart), quint16(qGreen(rgb) * tintPart), quint16(qRed(rgb) * tintPart), 0}};
+    forEachScanLine(image, currentKernels().linear, factors);
+    restoreFormat(image, format);
+}
+
+void darken(QImage &image, float amount)
+{
+    if (image.isNull()) {
+        return;
+    }
+    // Scaling the colors towards black works the same with premultiplied alpha
+    const QImage::Format format = ensureArgb32(image, true);
+
+    const quint16 color = 256 - fixedPoint(amount);
+    const LinearFactors factors{{color, color, color, 256}, {0, 0, 0, 0}};
+    forEachScanLine(image, currentKernels().linear, factors);
+    restoreFormat(image, format);
+}
+
+QColor blended(const QColor &background, const QColor &overlay)
+{
+    // Same as tinting a single pixel
+    quint32 pixel = background.rgb();
+    const quint16 tintPart = fixedPoint(overlay.alphaF());
+    const quint16 imagePart = 256 - tintPart;
+    const QRgb rgb = overlay.rgb();
+    const LinearFactors factors{{imagePart, imagePart, imagePart, 256},
+                                {quint16(qBlue(rgb) * tintPart), quint16(qGreen(rgb) * tintPart), quint16(qRed(rgb) * tintPart), 0}};
+    linearGeneric(&pixel, 1, factors);
+    return QColor::fromRgb(pixel);
+}
+}
@@ -0,0 +1,83 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KIMAGEEFFECTS_P_H
+#define KIMAGEEFFECTS_P_H
+
+#include <QColor>
+#include <QImage>
+#include <QList>
+
+/*
+ * Pixel effects used for rendering the widgets.
+ *
+ * All effects work in place on 32 bit images, other formats are converted first.
+ * The pixel loops have SIMD implementations (SSE2, AVX2 or NEON), chosen at runtime
+ * depending on the CPU, with a generic implementation as fallback. All
+ * implementations give identical results.
+ */
+namespace KImageEffects
+{
+enum class Implementation {
+    Generic,
+    Sse2,
+    Avx2,
+    Neon,
+};
+
+/*
+ * Returns the implementations usable on this machine, the generic one first.
+ */
+QList<Implementation> availableImplementations();
+
+/*
+ * Returns the implementation in use, by default the best one available.
+ */
+Implementation implementation();
+
+/*
+ * Sets the implementation to use, only meant for testing and benchmarking.
+ * Returns false if \a implementation is not available.
+ */
+bool setImplementation(Implementation implementation);
+
+/*
+ * Moves the colors towards their gray value (as qGray()) by \a amount, from 0 to 1.
+ */
+void desaturate(QImage &image, float amount);
+
+/*
+ * Replaces the colors with their gray value (as qGray()).
+ */
+inline void grayscale(QImage &image)
+{
+    desaturate(image, 1.0f);
+}
+
+/*
+ * Multiplies the alpha channel with \a factor, from 0 to 1.
+ */
+void scaleAlpha(QImage &image, float factor);
+
+/*
+ * Moves the colors towards \a color by \a amount, from 0 to 1, keeping the alpha channel.
+ */
+void tint(QImage &image, const QColor &color, float amount);
+
+/*
+ * Darkens the colors by \a amount, from 0 (unchanged) to 1 (black), keeping the alpha channel.
+ * This is the same as painting black with an alpha of \a amount atop of the image.
+ */
+void darken(QImage &image, float amount);
+
+/*
+ * Returns \a overlay, including its alpha, painted over the opaque \a background.
+ */
+QColor blended(const QColor &background, const QColor &overlay);
+}
+
+#endif
@@ -8,7 +8,8 @@
 
 #include "kled.h"
 
-#include <QImage>
+#include "kledrenderer_p.h"
+
 #include <QPainter>
 #include <QStyle>
 #include <QStyleOption>
@@ -22,9 +23,32 @@ public:
     KLed::Look look = KLed::Raised;
     KLed::Shape shape = KLed::Circular;
 
-    QPixmap cachedPixmap[2]; // for both states
+    KLedAppearance appearance(const QPalette &palette) const;
+    void clearCachedPixmaps();
+
+    QPixmap cachedPixmap[2]; // for both states, kept when toggling
+    // What the cached pixmaps were rendered for besides the own properties
+    qint64 paletteCacheKey = 0;
+    qreal devicePixelRatio = 0.0;
 };
 
+KLedAppearance KLedPrivate::appearance(const QPalette &palette) const
+{
+    KLedAppearance appearance;
+    appearance.color = color;
+    appearance.darkFactor = darkFactor;
+    appearance.look = look;
+    appearance.shape = shape;
+    appearance.setPalette(palette);
+    return appearance;
+}
+
+void KLedPrivate::clearCachedPixmaps()
+{
+    cachedPixmap[KLed::Off] = QPixmap();
+    cachedPixmap[KLed::On] = QPixmap();
+}
+
 KLed::KLed(QWidget *parent)
     : QWidget(parent)
     , d(new KLedPrivate)
@@ -82,7 +106,7 @@ void KLed::setState(State state)
     }
 
     d->state = (state == Off ? Off : On);
-    updateCachedPixmap();
+    update();
     updateAccessibleName();
 }
 
@@ -134,7 +158,7 @@ void KLed::setLook(Look look)
 void KLed::toggle()
 {
     d->state = (d->state == On ? Off : On);
-    updateCachedPixmap();
+    update();
     updateAccessibleName();
 }
 
@@ -183,79 +207,27 @@ void KLed::updateAccessibleName()
 
 void KLed::updateCachedPixmap()
 {
-    d->cachedPixmap[Off] = QPixmap();
-    d->cachedPixmap[On] = QPixmap();
+    d->clearCachedPixmaps();
     update();
 }
 
 void KLed::paintEvent(QPaintEvent *)
 {
-    if (!d->cachedPixmap[d->state].isNull()) {
-        QPainter painter(this);
-        painter.drawPixmap(1, 1, d->cachedPixmap[d->state]);
-        return;
+    const qreal dpr = devicePixelRatioF();
+    const qint64 paletteCacheKey = palette().cacheKey();
+    if (paletteCacheKey != d->paletteCacheKey || dpr != d->devicePixelRatio) {
+        d->clearCachedPixmaps();
+        d->paletteCacheKey = paletteCacheKey;
+        d->devicePixelRatio = dpr;
     }
 
-    QSize size(width() - 2, height() - 2);
-    if (d->shape == Circular) {
-        // Make sure the LED is round
-        const int dim = qMin(width(), height()) - 2;
-        size = QSize(dim, dim);
-    }
-    QPointF center(size.width() / 2.0, size.height() / 2.0);
-    const int smallestSize = qMin(size.width(), size.height());
-    QPainter painter;
-
-    QImage image(size, QImage::Format_ARGB32_Premultiplied);
-    image.fill(0);
-
-    QRadialGradient fillGradient(center, smallestSize / 2.0, QPointF(center.x(), size.height() / 3.0));
-    const QColor fillColor = d->state != Off ? d->color : d->color.darker(d->darkFactor);
-    fillGradient.setColorAt(0.0, fillColor.lighter(250));
-    fillGradient.setColorAt(0.5, fillColor.lighter(130));
-    fillGradient.setColorAt(1.0, fillColor);
-
-    QConicalGradient borderGradient(center, d->look == Sunken ? 90 : -90);
-    QColor borderColor = palette().color(QPalette::Dark);
-    if (d->state == On) {
-        QColor glowOverlay = fillColor;
-        glowOverlay.setAlpha(80);
-
-        // This isn't the fastest way, but should be "fast enough".
-        // It's also the only safe way to use QPainter::CompositionMode
-        QImage img(1, 1, QImage::Format_ARGB32_Premultiplied);
-        QPainter p(&img);
-        QColor start = borderColor;
-        start.setAlpha(255); // opaque
-        p.fillRect(0, 0, 1, 1, start);
-        p.setCompositionMode(QPainter::CompositionMode_SourceOver);
-        p.fillRect(0, 0, 1, 1, glowOverlay);
-        p.end();
-
-        borderColor = img.pixel(0, 0);
-    }
-    borderGradient.setColorAt(0.2, borderColor);
-    borderGradient.setColorAt(0.5, palette().color(QPalette::Light));
-    borderGradient.setColorAt(0.8, borderColor);
-
-    painter.begin(&image);
-    painter.setRenderHint(QPainter::Antialiasing);
-    painter.setBrush(d->look == Flat ? QBrush(fillColor) : QBrush(fillGradient));
-    const QBrush penBrush = (d->look == Flat) ? QBrush(borderColor) : QBrush(borderGradient);
-    const qreal penWidth = smallestSize / 8.0;
-    painter.setPen(QPen(penBrush, penWidth));
-    QRectF r(penWidth / 2.0, penWidth / 2.0, size.width() - penWidth, size.height() - penWidth);
-    if (d->shape == Rectangular) {
-        painter.drawRect(r);
-    } else {
-        painter.drawEllipse(r);
+    QPixmap &pixmap = d->cachedPixmap[d->state];
+    if (pixmap.isNull()) {
+        pixmap = KLedRenderer::pixmap(d->appearance(palette()), d->state, KLedRenderer::ledSize(size(), d->shape), dpr);
     }
-    painter.end();
 
-    d->cachedPixmap[d->state] = QPixmap::fromImage(image);
-    painter.begin(this);
-    painter.drawPixmap(1, 1, d->cachedPixmap[d->state]);
-    painter.end();
+    QPainter painter(this);
+    painter.drawPixmap(1, 1, pixmap);
 }
 
 #include "moc_kled.cpp"
@@ -0,0 +1,371 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kledmatrix.h"
+
+#include "kledrenderer_p.h"
+
+#include <QPaintEvent>
+#include <QPainter>
+#include <QStyle>
+#include <QStyleOption>
+
+#include <algorithm>
+#include <vector>
+
+class KLedMatrixPrivate
+{
+public:
+    explicit KLedMatrixPrivate(KLedMatrix *qq)
+        : q(qq)
+    {
+    }
+
+    void resize(int newRowCount, int newColumnCount);
+    QRect cellRect(int row, int column) const;
+    // Repaints the cells from index first to index last
+    void updateCells(int first, int last);
+    void updateAppearance();
+
+    KLedMatrix *const q;
+
+    int rowCount = 0;
+    int columnCount = 0;
+    std::vector<KLed::State> states; // row by row
+
+    QSize cellSize; // invalid for the default
+    QColor color = Qt::green;
+    int darkFactor = 300;
+    KLed::Look look = KLed::Raised;
+    KLed::Shape shape = KLed::Circular;
+
+    QPixmap cachedPixmap[2]; // for both states, shared by all cells
+    qint64 paletteCacheKey = 0;
+    qreal devicePixelRatio = 0.0;
+};
+
+void KLedMatrixPrivate::resize(int newRowCount, int newColumnCount)
+{
+    newRowCount = qMax(0, newRowCount);
+    newColumnCount = qMax(0, newColumnCount);
+    if (newRowCount == rowCount && newColumnCount == columnCount) {
+        return;
+    }
+
+    if (newColumnCount == columnCount) {
+        states.resize(size_t(newRowCount) * newColumnCount, KLed::Off);
+    } else {
+        std::vector<KLed::State> newStates(size_t(newRowCount) * newColumnCount, KLed::Off);
+        const int rows = qMin(rowCount, newRowCount);
+        const int columns = qMin(columnCount, newColumnCount);
+        for (int row = 0; row < rows; ++row) {
+            const auto source = states.cbegin() + size_t(row) * columnCount;
+            std::copy(source, source + columns, newStates.begin() + size_t(row) * newColumnCount);
+        }
+        states = std::move(newStates);
+    }
+
+    rowCount = newRowCount;
+    columnCount = newColumnCount;
+    q->updateGeometry();
+    q->update();
+}
+
+QRect KLedMatrixPrivate::cellRect(int row, int column) const
+{
+    const QSize size = q->cellSize();
+    return QRect(QPoint(column * size.width(), row * size.height()), size);
+}
+
+void KLedMatrixPrivate::updateCells(int first, int last)
+{
+    const int firstRow = first / columnCount;
+    const int lastRow = last / columnCount;
+    if (firstRow == lastRow) {
+        q->update(cellRect(firstRow, first % columnCount).united(cellRect(lastRow, last % columnCount)));
+    } else {
+        q->update(cellRect(firstRow, 0).united(cellRect(lastRow, columnCount - 1)));
+    }
+}
+
+void KLedMatrixPrivate::updateAppearance()
+{
+    cachedPixmap[KLed::Off] = QPixmap();
+    cachedPixmap[KLed::On] = QPixmap();
+    q->update();
+}
+
+KLedMatrix::KLedMatrix(QWidget *parent)
+    : KLedMatrix(0, 0, parent)
+{
+}
+
+KLedMatrix::KLedMatrix(int rowCount, int columnCount, QWidget *parent)
+    : QWidget(parent)
+    , d(new KLedMatrixPrivate(this))
+{
+    d->resize(rowCount, columnCount);
+}
+
+KLedMatrix::~KLedMatrix() = default;
+
+int KLedMatrix::rowCount() const
+{
+    return d->rowCount;
+}
+
+void KLedMatrix::setRowCount(int rowCount)
+{
+    d->resize(rowCount, d->columnCount);
+}
+
+int KLedMatrix::columnCount() const
+{
+    return d->columnCount;
+}
+
+void KLedMatrix::setColumnCount(int columnCount)
+{
+    d->resize(d->rowCount, columnCount);
+}
+
+int KLedMatrix::count() const
+{
+    return int(d->states.size());
+}
+
+QSize KLedMatrix::cellSize() const
+{
+    if (d->cellSize.isValid()) {
+        return d->cellSize;
+    }
+
+    // Same as the size hint of KLed
+    QStyleOption option;
+    option.initFrom(this);
+    const int iconSize = style()->pixelMetric(QStyle::PM_SmallIconSize, &option, this);
+    return QSize(iconSize, iconSize);
+}
+
+void KLedMatrix::setCellSize(const QSize &size)
+{
+    if (d->cellSize == size) {
+        return;
+    }
+
+    d->cellSize = size;
+    updateGeometry();
+    d->updateAppearance();
+}
+
+QColor KLedMatrix::color() const
+{
+    return d->color;
+}
+
+void KLedMatrix::setColor(const QColor &color)
+{
+    if (d->color == color) {
+        return;
+    }
+
+    d->color = color;
+    d->updateAppearance();
+}
+
+KLed::Look KLedMatrix::look() const
+{
+    return d->look;
+}
+
+void KLedMatrix::setLook(KLed::Look look)
+{
+    if (d->look == look) {
+        return;
+    }
+
+    d->look = look;
+    d->updateAppearance();
+}
+
+KLed::Shape KLedMatrix::shape() const
+{
+    return d->shape;
+}
+
+void KLedMatrix::setShape(KLed::Shape shape)
+{
+    if (d->shape == shape) {
+        return;
+    }
+
+    d->shape = shape;
+    d->updateAppearance();
+}
+
+int KLedMatrix::darkFactor() const
+{
+    return d->darkFactor;
+}
+
+void KLedMatrix::setDarkFactor(int darkFactor)
+{
+    if (d->darkFactor == darkFactor) {
+        return;
+    }
+
+    d->darkFactor = darkFactor;
+    d->updateAppearance();
+}
+
+KLed::State KLedMatrix::state(int index) const
+{
+    if (index < 0 || index >= count()) {
+        return KLed::Off;
+    }
+    return d->states[index];
+}
+
+KLed::State KLedMatrix::state(int row, int column) const
+{
+    if (column < 0 || column >= d->columnCount) {
+        return KLed::Off;
+    }
+    return state(row * d->columnCount + column);
+}
+
+void KLedMatrix::setState(int index, KLed::State state)
+{
+    if (index < 0 || index >= count()) {
+        return;
+    }
+
+    state = (state == KLed::Off ? KLed::Off : KLed::On);
+    if (d->states[index] == state) {
+        return;
+    }
+
+    d->states[index] = state;
+    d->updateCells(index, index);
+}
+
+void KLedMatrix::setState(int row, int column, KLed::State state)
+{
+    if (column < 0 || column >= d->columnCount) {
+        return;
+    }
+    setState(row * d->columnCount + column, state);
+}
+
+void KLedMatrix::setStates(QSpan<const KLed::State> states, int first)
+{
+    if (first < 0 || first >= count()) {
+        return;
+    }
+
+    const int last = int(qMin<qsizetype>(count(), first + states.size()));
+    // Only the range of changed cells is repainted
+    int firstChanged = last;
+    int lastChanged = -1;
+    for (int index = first; index < last; ++index) {
+        const KLed::State state = (states[index - first] == KLed::Off ? KLed::Off : KLed::On);
+        if (d->states[index] != state) {
+            d->states[index] = state;
+            firstChanged = qMin(firstChanged, index);
+            lastChanged = index;
+        }
+    }
+
+    if (lastChanged >= 0) {
+        d->updateCells(firstChanged, lastChanged);
+    }
+}
+
+void KLedMatrix::setAllStates(KLed::State state)
+{
+    state = (state == KLed::Off ? KLed::Off : KLed::On);
+    if (std::all_of(d->states.cbegin(), d->states.cend(), [state](KLed::State s) {
+            return s == state;
+        })) {
+        return;
+    }
+
+    std::fill(d->states.begin(), d->states.end(), state);
+    update();
+}
+
+void KLedMatrix::toggle(int index)
+{
+    setState(index, state(index) == KLed::On ? KLed::Off : KLed::On);
+}
+
+QSize KLedMatrix::sizeHint() const
+{
+    const QSize size = cellSize();
+    return QSize(d->columnCount * size.width(), d->rowCount * size.height());
+}
+
+QSize KLedMatrix::minimumSizeHint() const
+{
+    return sizeHint();
+}
+
+void KLedMatrix::paintEvent(QPaintEvent *event)
+{
+    if (d->states.empty()) {
+        return;
+    }
+
+    const qreal dpr = devicePixelRatioF();
+    const qint64 paletteCacheKey = palette().cacheKey();
+    if (paletteCacheKey != d->paletteCacheKey || dpr != d->devicePixelRatio) {
+        d->cachedPixmap[KLed::Off] = QPixmap();
+        d->cachedPixmap[KLed::On] = QPixmap();
+        d->paletteCacheKey = paletteCacheKey;
+        d->devicePixelRatio = dpr;
+    }
+
+    const QSize size = cellSize();
+    if (size.isEmpty()) {
+        return;
+    }
+
+    if (d->cachedPixmap[KLed::Off].isNull()) {
+        KLedAppearance appearance;
+        appearance.color = d->color;
+        appearance.darkFactor = d->darkFactor;
+        appearance.look = d->look;
+        appearance.shape = d->shape;
+        appearance.setPalette(palette());
+
+        const QSize ledSize = KLedRenderer::ledSize(size, d->shape);
+        d->cachedPixmap[KLed::Off] = KLedRenderer::pixmap(appearance, KLed::Off, ledSize, dpr);
+        d->cachedPixmap[KLed::On] = KLedRenderer::pixmap(appearance, KLed::On, ledSize, dpr);
+    }
+
+    // Only the cells within the dirty region
+    const QRegion &region = event->region();
+    const QRect rect = event->rect();
+    const bool singleRect = region.rectCount() == 1;
+    const int firstRow = qMax(0, rect.top() / size.height());
+    const int lastRow = qMin(d->rowCount - 1, rect.bottom() / size.height());
+    const int firstColumn = qMax(0, rect.left() / size.width());
+    const int lastColumn = qMin(d->columnCount - 1, rect.right() / size.width());
+
+    QPainter painter(this);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        const KLed::State *rowStates = d->states.data() + size_t(row) * d->columnCount;
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            const QRect cell(QPoint(column * size.width(), row * size.height()), size);
+            if (singleRect || region.intersects(cell)) {
+                painter.drawPixmap(cell.topLeft() + QPoint(1, 1), d->cachedPixmap[rowStates[column]]);
+            }
+        }
+    }
+}
+
+#include "moc_kledmatrix.cpp"
@@ -0,0 +1,257 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KLEDMATRIX_H
+#define KLEDMATRIX_H
+
+#include <kwidgetsaddons_export.h>
+
+#include <KLed>
+
+#include <QSpan>
+#include <QWidget>
+#include <memory>
+
+/*!
+ * \class KLedMatrix
+ * \inmodule KWidgetsAddons
+ *
+ * \brief A grid of LEDs in a single widget.
+ *
+ * Displays rowCount() times columnCount() LEDs which look like KLed, all
+ * sharing the same color, look, shape and dark factor, each with its own
+ * state.
+ *
+ * Compared to a grid of KLed widgets this is much lighter for large boards:
+ * the states are kept in a flat array, addressed either by row and column
+ * or by the index row * columnCount() + column, the LEDs are drawn from
+ * pixmaps shared with all other LEDs of the same appearance, and a state
+ * change only repaints the changed cells. Many states can be set at once
+ * with setStates().
+ *
+ * \code
+ * auto matrix = new KLedMatrix(100, 100, parent);
+ * matrix->setColor(Qt::red);
+ * matrix->setStates(states); // e.g. a QList<KLed::State> of 10000 states
+ * \endcode
+ *
+ * \sa KLed
+ * \since 6.30
+ */
+class KWIDGETSADDONS_EXPORT KLedMatrix : public QWidget
+{
+    Q_OBJECT
+
+    /*!
+     * \property KLedMatrix::rowCount
+     */
+    Q_PROPERTY(int rowCount READ rowCount WRITE setRowCount)
+
+    /*!
+     * \property KLedMatrix::columnCount
+     */
+    Q_PROPERTY(int columnCount READ columnCount WRITE setColumnCount)
+
+    /*!
+     * \property KLedMatrix::cellSize
+     */
+    Q_PROPERTY(QSize cellSize READ cellSize WRITE setCellSize)
+
+    /*!
+     * \property KLedMatrix::shape
+     */
+    Q_PROPERTY(KLed::Shape shape READ shape WRITE setShape)
+
+    /*!
+     * \property KLedMatrix::look
+     */
+    Q_PROPERTY(KLed::Look look READ look WRITE setLook)
+
+    /*!
+     * \property KLedMatrix::color
+     */
+    Q_PROPERTY(QColor color READ color WRITE setColor)
+
+    /*!
+     * \property KLedMatrix::darkFactor
+     */
+    Q_PROPERTY(int darkFactor READ darkFactor WRITE setDarkFactor)
+
+public:
+    /*!
+     * Constructs an empty LED matrix.
+     *
+     * \a parent The parent widget.
+     */
+    explicit KLedMatrix(QWidget *parent = nullptr);
+
+    /*!
+     * Constructs a matrix of \a rowCount times \a columnCount green, round LEDs,
+     * which will initially be turned off.
+     *
+     * \a parent The parent widget.
+     */
+    KLedMatrix(int rowCount, int columnCount, QWidget *parent = nullptr);
+
+    ~KLedMatrix() override;
+
+    /*!
+     * Returns the number of rows.
+     */
+    int rowCount() const;
+
+    /*!
+     * Sets the number of rows to \a rowCount.
+     *
+     * The states of the LEDs in the remaining rows are kept,
+     * LEDs in new rows are turned off.
+     */
+    void setRowCount(int rowCount);
+
+    /*!
+     * Returns the number of columns.
+     */
+    int columnCount() const;
+
+    /*!
+     * Sets the number of columns to \a columnCount.
+     *
+     * The states of the LEDs in the remaining columns are kept,
+     * LEDs in new columns are turned off.
+     */
+    void setColumnCount(int columnCount);
+
+    /*!
+     * Returns the number of LEDs, rowCount() times columnCount().
+     */
+    int count() const;
+
+    /*!
+     * Returns the size of the cell of each LED.
+     *
+     * By default this is the small icon size of the style.
+     *
+     * \sa setCellSize()
+     */
+    QSize cellSize() const;
+
+    /*!
+     * Sets the size of the cell of each LED to \a size.
+     *
+     * Passing an invalid size restores the default.
+     *
+     * \sa cellSize()
+     */
+    void setCellSize(const QSize &size);
+
+    /*!
+     * Returns the color of the LEDs.
+     *
+     * \sa KLed::color()
+     */
+    QColor color() const;
+
+    /*!
+     * Sets the color of the LEDs to \a color.
+     *
+     * \sa KLed::setColor()
+     */
+    void setColor(const QColor &color);
+
+    /*!
+     * Returns the look of the LEDs.
+     *
+     * \sa KLed::look()
+     */
+    KLed::Look look() const;
+
+    /*!
+     * Sets the look of the LEDs to \a look.
+     *
+     * \sa KLed::setLook()
+     */
+    void setLook(KLed::Look look);
+
+    /*!
+     * Returns the shape of the LEDs.
+     *
+     * \sa KLed::shape()
+     */
+    KLed::Shape shape() const;
+
+    /*!
+     * Sets the shape of the LEDs to \a shape.
+     *
+     * \sa KLed::setShape()
+     */
+    void setShape(KLed::Shape shape);
+
+    /*!
+     * Returns the factor to darken the LEDs in KLed::Off state.
+     *
+     * \sa KLed::darkFactor()
+     */
+    int darkFactor() const;
+
+    /*!
+     * Sets the factor to darken the LEDs in KLed::Off state to \a darkFactor.
+     *
+     * Defaults to 300.
+     *
+     * \sa KLed::setDarkFactor()
+     */
+    void setDarkFactor(int darkFactor);
+
+    /*!
+     * Returns the state of the LED at \a index.
+     */
+    KLed::State state(int index) const;
+
+    /*!
+     * Returns the state of the LED at \a row and \a column.
+     */
+    KLed::State state(int row, int column) const;
+
+    /*!
+     * Sets the state of the LED at \a index to \a state.
+     */
+    void setState(int index, KLed::State state);
+
+    /*!
+     * Sets the state of the LED at \a row and \a column to \a state.
+     */
+    void setState(int row, int column, KLed::State state);
+
+    /*!
+     * Sets the states of the LEDs starting at index \a first to \a states.
+     *
+     * States beyond the last LED are ignored. Only the cells whose state
+     * changed are repainted.
+     */
+    void setStates(QSpan<const KLed::State> states, int first = 0);
+
+    /*!
+     * Sets the state of all LEDs to \a state.
+     */
+    void setAllStates(KLed::State state);
+
+    /*!
+     * Toggles the state of the LED at \a index.
+     */
+    void toggle(int index);
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent *) override;
+
+private:
+    std::unique_ptr<class KLedMatrixPrivate> const d;
+};
+
+#endif
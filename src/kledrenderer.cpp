@@ -0,0 +1,158 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 1998 Jörg Habenicht <j.habenicht@europemail.com>
+    SPDX-FileCopyrightText: 2010 Christoph Feck <cfeck@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "kledrenderer_p.h"
+
+#include "kimageeffects_p.h"
+
+#include <QCache>
+#include <QGlobalStatic>
+#include <QImage>
+#include <QPainter>
+#include <QPalette>
+
+namespace
+{
+struct LedKey {
+    QRgb color;
+    int darkFactor;
+    KLed::Look look;
+    KLed::Shape shape;
+    QRgb darkColor;
+    QRgb lightColor;
+    KLed::State state;
+    QSize size;
+    qreal devicePixelRatio;
+
+    bool operator==(const LedKey &other) const
+    {
+        return color == other.color && darkFactor == other.darkFactor && look == other.look && shape == other.shape && darkColor == other.darkColor
+            && lightColor == other.lightColor && state == other.state && size == other.size && devicePixelRatio == other.devicePixelRatio;
+    }
+};
+
+size_t qHash(const LedKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed,
+                      key.color,
+                      key.darkFactor,
+                      int(key.look),
+                      int(key.shape),
+                      key.darkColor,
+                      key.lightColor,
+                      int(key.state),
+                      key.size.width(),
+                      key.size.height(),
+                      key.devicePixelRatio);
+}
+
+QPixmap render(const KLedAppearance &appearance, KLed::State state, const QSize &size, qreal devicePixelRatio)
+{
+    QPointF center(size.width() / 2.0, size.height() / 2.0);
+    const int smallestSize = qMin(size.width(), size.height());
+    QPainter painter;
+
+    QImage image(size * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(devicePixelRatio);
+    image.fill(0);
+
+    QRadialGradient fillGradient(center, smallestSize / 2.0, QPointF(center.x(), size.height() / 3.0));
+    const QColor fillColor = state != KLed::Off ? appearance.color : appearance.color.darker(appearance.darkFactor);
+    fillGradient.setColorAt(0.0, fillColor.lighter(250));
+    fillGradient.setColorAt(0.5, fillColor.lighter(130));
+    fillGradient.setColorAt(1.0, fillColor);
+
+    QConicalGradient borderGradient(center, appearance.look == KLed::Sunken ? 90 : -90);
+    QColor borderColor = appearance.darkColor;
+    if (state == KLed::On) {
+        QColor glowOverlay = fillColor;
+        glowOverlay.setAlpha(80);
+
+        QColor start = borderColor;
+        start.setAlpha(255); // opaque
+        borderColor = KImageEffects::blended(start, glowOverlay);
+    }
+    borderGradient.setColorAt(0.2, borderColor);
+    borderGradient.setColorAt(0.5, appearance.lightColor);
+    borderGradient.setColorAt(0.8, borderColor);
+
+    painter.begin(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setBrush(appearance.look == KLed::Flat ? QBrush(fillColor) : QBrush(fillGradient));
+    const QBrush penBrush = (appearance.look == KLed::Flat) ? QBrush(borderColor) : QBrush(borderGradient);
+    const qreal penWidth = smallestSize / 8.0;
+    painter.setPen(QPen(penBrush, penWidth));
+    QRectF r(penWidth / 2.0, penWidth / 2.0, size.width() - penWidth, size.height() - penWidth);
+    if (appearance.shape == KLed::Rectangular) {
+        painter.drawRect(r);
+    } else {
+        painter.drawEllipse(r);
+    }
+    painter.end();
+
+    return QPixmap::fromImage(std::move(image));
+}
+}
+
+// Rendered LEDs shared by all KLed and KLedMatrix instances,
+// a panel full of LEDs usually only has a few different ones.
+class KLedPixmapCache
+{
+public:
+    KLedPixmapCache()
+    {
+        // in KiB
+        m_pixmaps.setMaxCost(4 * 1024);
+    }
+
+    QCache<LedKey, QPixmap> m_pixmaps;
+};
+
+Q_GLOBAL_STATIC(KLedPixmapCache, s_pixmapCache)
+
+void KLedAppearance::setPalette(const QPalette &palette)
+{
+    darkColor = palette.color(QPalette::Dark);
+    lightColor = palette.color(QPalette::Light);
+}
+
+QSize KLedRenderer::ledSize(const QSize &cellSize, KLed::Shape shape)
+{
+    QSize size(cellSize.width() - 2, cellSize.height() - 2);
+    if (shape == KLed::Circular) {
+        // Make sure the LED is round
+        const int dim = qMin(cellSize.width(), cellSize.height()) - 2;
+        size = QSize(dim, dim);
+    }
+    return size;
+}
+
+QPixmap KLedRenderer::pixmap(const KLedAppearance &appearance, KLed::State state, const QSize &size, qreal devicePixelRatio)
+{
+    if (size.isEmpty()) {
+        return QPixmap();
+    }
+
+    LedKey key{appearance.color.rgba(),
+               appearance.darkFactor,
+               appearance.look,
+               appearance.shape,
+               appearance.darkColor.rgba(),
+               appearance.lightColor.rgba(),
+               state,
+               size,
+               devicePixelRatio};
+    if (const QPixmap *pixmap = s_pixmapCache()->m_pixmaps.object(key)) {
+        return *pixmap;
+    }
+
+    const QPixmap pixmap = render(appearance, state, size, devicePixelRatio);
+    const qsizetype cost = std::max<qsizetype>(1, qsizetype(pixmap.width()) * pixmap.height() * 4 / 1024);
+    s_pixmapCache()->m_pixmaps.insert(std::move(key), new QPixmap(pixmap), cost);
+    return pixmap;
+}
@@ -0,0 +1,42 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 1998 Jörg Habenicht <j.habenicht@europemail.com>
+    SPDX-FileCopyrightText: 2010 Christoph Feck <cfeck@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KLEDRENDERER_P_H
+#define KLEDRENDERER_P_H
+
+#include "kled.h"
+
+#include <QColor>
+#include <QPixmap>
+
+class QPalette;
+
+// Everything but the state and the size which determines how an LED is rendered
+struct KLedAppearance {
+    QColor color;
+    int darkFactor = 300;
+    KLed::Look look = KLed::Raised;
+    KLed::Shape shape = KLed::Circular;
+    // Colors of the border, from the palette
+    QColor darkColor;
+    QColor lightColor;
+
+    void setPalette(const QPalette &palette);
+};
+
+namespace KLedRenderer
+{
+// Size of the LED drawn into a cell of size, without the border of one pixel around it
+QSize ledSize(const QSize &cellSize, KLed::Shape shape);
+
+// Returns the pixmap for an LED of size, rendered only once per process for
+// the same appearance, state, size and devicePixelRatio as long as it is in use.
+QPixmap pixmap(const KLedAppearance &appearance, KLed::State state, const QSize &size, qreal devicePixelRatio);
+}
+
+#endif
@@ -11,15 +11,100 @@
 #include <QMimeDatabase>
 
 #include <QDialogButtonBox>
+#include <QFuture>
+#include <QHash>
 #include <QLabel>
 #include <QLineEdit>
+#include <QPromise>
 #include <QPushButton>
+#include <QSet>
 #include <QSortFilterProxyModel>
 #include <QStandardItemModel>
 #include <QStandardPaths>
+#include <QThreadPool>
 #include <QTreeView>
 #include <QVBoxLayout>
 
+#include <memory>
+
+namespace
+{
+// What is shown of a MIME type, gathered off the GUI thread
+struct MimeTypeEntry {
+    // e.g. "text", "audio", "inode"
+    QString group;
+    // e.g. "html", "plain", "mp4"
+    QString subType;
+    QString iconName;
+    QString comment;
+    QString patterns;
+};
+
+QList<MimeTypeEntry> collectMimeTypes(const QStringList &groups, int visuals)
+{
+    QList<MimeTypeEntry> entries;
+    QMimeDatabase db;
+    const QList<QMimeType> mimetypes = db.allMimeTypes();
+    entries.reserve(mimetypes.size());
+
+    for (const QMimeType &mt : mimetypes) {
+        const QString mimetype = mt.name();
+        const int index = mimetype.indexOf(QLatin1Char('/'));
+        QString maj = mimetype.left(index);
+
+        if (!groups.isEmpty() && !groups.contains(maj)) {
+            continue;
+        }
+
+        MimeTypeEntry entry;
+        entry.group = std::move(maj);
+        entry.subType = mimetype.mid(index + 1);
+        entry.iconName = mt.iconName();
+        if (visuals & KMimeTypeChooser::Comments) {
+            entry.comment = mt.comment();
+        }
+        if (visuals & KMimeTypeChooser::Patterns) {
+            entry.patterns = mt.globPatterns().join(QLatin1String("; "));
+        }
+        entries.append(std::move(entry));
+    }
+
+    // Sorted like the model would sort the items
+    std::sort(entries.begin(), entries.end(), [](const MimeTypeEntry &a, const MimeTypeEntry &b) {
+        return a.group != b.group ? a.group < b.group : a.subType < b.subType;
+    });
+    return entries;
+}
+
+// Item of a MIME type, which only looks up its icon once shown
+class MimeTypeItem : public QStandardItem
+{
+public:
+    MimeTypeItem(const QString &iconName, const QString &text)
+        : QStandardItem(text)
+        , m_iconName(iconName)
+    {
+    }
+
+    QVariant data(int role = Qt::UserRole + 1) const override
+    {
+        if (role == Qt::DecorationRole && !m_iconName.isEmpty()) {
+            if (!m_iconResolved) {
+                m_icon = QIcon::fromTheme(m_iconName);
+                m_iconResolved = true;
+            }
+            return m_icon;
+        }
+        return QStandardItem::data(role);
+    }
+
+private:
+    const QString m_iconName;
+    mutable QIcon m_icon;
+    mutable bool m_iconResolved = false;
+};
+}
+
 // BEGIN KMimeTypeChooserPrivate
 class KMimeTypeChooserPrivate
 {
@@ -30,6 +115,7 @@ public:
     }
 
     void loadMimeTypes(const QStringList &selected = QStringList());
+    void populate(const QList<MimeTypeEntry> &entries);
     QList<const QStandardItem *> getCheckedItems();
 
     void editMimeType();
@@ -46,6 +132,11 @@ public:
     QString defaultgroup;
     QStringList groups;
     int visuals;
+
+    // Checked MIME types while the model is still being loaded
+    QStringList pendingSelection;
+    bool loading = false;
+    int loadSerial = 0;
 };
 // END
 
@@ -148,79 +239,84 @@ KMimeTypeChooser::~KMimeTypeChooser() = default;
 
 void KMimeTypeChooserPrivate::loadMimeTypes(const QStringList &_selectedMimeTypes)
 {
-    QStringList selMimeTypes;
-
     if (!_selectedMimeTypes.isEmpty()) {
-        selMimeTypes = _selectedMimeTypes;
+        pendingSelection = _selectedMimeTypes;
     } else {
-        selMimeTypes = q->mimeTypes();
+        pendingSelection = q->mimeTypes();
     }
+    loading = true;
+
+    // Going through all MIME types takes a while, so do it on a worker thread
+    // and fill the tree once done. A newer load makes older results obsolete.
+    const int serial = ++loadSerial;
+    auto promise = std::make_shared<QPromise<QList<MimeTypeEntry>>>();
+    QFuture<QList<MimeTypeEntry>> future = promise->future();
+    promise->start();
+    QThreadPool::globalInstance()->start([promise, groupsToShow = groups, shownVisuals = visuals]() {
+        promise->addResult(collectMimeTypes(groupsToShow, shownVisuals));
+        promise->finish();
+    });
+    future.then(q, [this, serial](const QList<MimeTypeEntry> &entries) {
+        if (serial == loadSerial) {
+            populate(entries);
+        }
+    });
+}
 
-    std::vector<QStandardItem *> parentGroups;
-    QMimeDatabase db;
-    const QList<QMimeType> mimetypes = db.allMimeTypes();
+void KMimeTypeChooserPrivate::populate(const QList<MimeTypeEntry> &entries)
+{
+    const QSet<QString> selMimeTypes(pendingSelection.cbegin(), pendingSelection.cend());
+    loading = false;
+    pendingSelection.clear();
+
+    QHash<QString, QStandardItem *> groupItems;
+    QList<QList<QStandardItem *>> groupRows;
 
     bool agroupisopen = false;
     QStandardItem *idefault = nullptr; // open this, if all other fails
     QStandardItem *firstChecked = nullptr; // make this one visible after the loop
+    QList<QStandardItem *> expandedGroups;
 
-    for (const QMimeType &mt : mimetypes) {
-        const QString mimetype = mt.name();
-        const int index = mimetype.indexOf(QLatin1Char('/'));
-        // e.g. "text", "audio", "inode"
-        const QString maj = mimetype.left(index);
-
-        if (!groups.isEmpty() && !groups.contains(maj)) {
-            continue;
-        }
-
-        QStandardItem *groupItem;
-
-        auto it = std::find_if(parentGroups.cbegin(), parentGroups.cend(), [maj](const QStandardItem *item) {
-            return maj == item->text();
-        });
-
-        if (it == parentGroups.cend()) {
-            groupItem = new QStandardItem(maj);
+    for (const MimeTypeEntry &entry : entries) {
+        QStandardItem *&groupItem = groupItems[entry.group];
+        if (!groupItem) {
+            groupItem = new QStandardItem(entry.group);
             groupItem->setFlags(Qt::ItemIsEnabled);
             // a dud item to fill the patterns column next to "groupItem" and setFlags() on it
             QStandardItem *secondColumn = new QStandardItem();
             secondColumn->setFlags(Qt::NoItemFlags);
             QStandardItem *thirdColumn = new QStandardItem();
             thirdColumn->setFlags(Qt::NoItemFlags);
-            m_model->appendRow({groupItem, secondColumn, thirdColumn});
-            parentGroups.push_back(groupItem);
-            if (maj == defaultgroup) {
+            groupRows.append({groupItem, secondColumn, thirdColumn});
+            if (entry.group == defaultgroup) {
                 idefault = groupItem;
             }
-        } else {
-            groupItem = *it;
         }
 
-        // e.g. "html", "plain", "mp4"
-        const QString min = mimetype.mid(index + 1);
-        QStandardItem *mime = new QStandardItem(QIcon::fromTheme(mt.iconName()), min);
+        QStandardItem *mime = new MimeTypeItem(entry.iconName, entry.subType);
         mime->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled);
 
         QStandardItem *comments = nullptr;
         if (visuals & KMimeTypeChooser::Comments) {
-            comments = new QStandardItem(mt.comment());
+            comments = new QStandardItem(entry.comment);
             comments->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
         }
 
         QStandardItem *patterns = nullptr;
 
         if (visuals & KMimeTypeChooser::Patterns) {
-            patterns = new QStandardItem(mt.globPatterns().join(QLatin1String("; ")));
+            patterns = new QStandardItem(entry.patterns);
             patterns->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
         }
 
+        // Not yet part of the model, so this does not notify the view
         groupItem->appendRow(QList<QStandardItem *>({mime, comments, patterns}));
 
-        if (selMimeTypes.contains(mimetype)) {
+        if (selMimeTypes.contains(entry.group + QLatin1Char('/') + entry.subType)) {
             mime->setCheckState(Qt::Checked);
-            const QModelIndex index = m_proxyModel->mapFromSource(m_model->indexFromItem(groupItem));
-            mimeTypeTree->expand(index);
+            if (!expandedGroups.contains(groupItem)) {
+                expandedGroups.append(groupItem);
+            }
             agroupisopen = true;
             if (!firstChecked) {
                 firstChecked = mime;
@@ -230,7 +326,15 @@ void KMimeTypeChooserPrivate::loadMimeTypes(const QStringList &_selectedMimeType
         }
     }
 
-    m_model->sort(0);
+    // Insert the complete groups, the entries are sorted already
+    m_model->removeRows(0, m_model->rowCount());
+    for (const QList<QStandardItem *> &row : std::as_const(groupRows)) {
+        m_model->appendRow(row);
+    }
+
+    for (const QStandardItem *groupItem : std::as_const(expandedGroups)) {
+        mimeTypeTree->expand(m_proxyModel->mapFromSource(m_model->indexFromItem(groupItem)));
+    }
 
     if (firstChecked) {
         const QModelIndex index = m_proxyModel->mapFromSource(m_model->indexFromItem(firstChecked));
@@ -304,6 +408,19 @@ QList<const QStandardItem *> KMimeTypeChooserPrivate::getCheckedItems()
 
 QStringList KMimeTypeChooser::mimeTypes() const
 {
+    if (d->loading) {
+        // Only what will be listed once loaded
+        QStringList mimeList;
+        QMimeDatabase db;
+        for (const QString &name : std::as_const(d->pendingSelection)) {
+            const bool shownGroup = d->groups.isEmpty() || d->groups.contains(name.section(QLatin1Char('/'), 0, 0));
+            if (shownGroup && db.mimeTypeForName(name).name() == name) {
+                mimeList.append(name);
+            }
+        }
+        return mimeList;
+    }
+
     QStringList mimeList;
     const QList<const QStandardItem *> checkedItems = d->getCheckedItems();
     mimeList.reserve(checkedItems.size());
@@ -316,10 +433,10 @@ QStringList KMimeTypeChooser::mimeTypes() const
 QStringList KMimeTypeChooser::patterns() const
 {
     QStringList patternList;
-    const QList<const QStandardItem *> checkedItems = d->getCheckedItems();
+    const QStringList mimeList = mimeTypes();
     QMimeDatabase db;
-    for (const QStandardItem *item : checkedItems) {
-        QMimeType mime = db.mimeTypeForName(item->parent()->text() + QLatin1Char('/') + item->text());
+    for (const QString &name : mimeList) {
+        QMimeType mime = db.mimeTypeForName(name);
         Q_ASSERT(mime.isValid());
         patternList += mime.globPatterns();
     }
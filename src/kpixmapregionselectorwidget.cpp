@@ -6,6 +6,8 @@
 */
 
 #include "kpixmapregionselectorwidget.h"
+#include "kimageeffects_p.h"
+
 #include <QAction>
 #include <QApplication>
 #include <QColor>
@@ -140,10 +142,9 @@ void KPixmapRegionSelectorWidgetPrivate::updatePixmap()
 
     QPainter painter;
     if (m_linedPixmap.isNull()) {
-        m_linedPixmap = m_originalPixmap;
-        QPainter p(&m_linedPixmap);
-        p.setCompositionMode(QPainter::CompositionMode_SourceAtop);
-        p.fillRect(m_linedPixmap.rect(), QColor(0, 0, 0, 100));
+        QImage image = m_originalPixmap.toImage();
+        KImageEffects::darken(image, 100 / 255.0f);
+        m_linedPixmap = QPixmap::fromImage(std::move(image));
     }
 
     QPixmap pixmap = m_linedPixmap;
@@ -6,19 +6,12 @@
 */
 
 #include "kpixmapsequence.h"
+#include "kpixmapsequence_p.h"
 
 #include "loggingcategory.h"
 
-#include <QList>
-#include <QPixmap>
-
-class KPixmapSequencePrivate : public QSharedData
-{
-public:
-    QList<QPixmap> mFrames;
-
-    void loadSequence(const QPixmap &bigPixmap, const QSize &frameSize);
-};
+#include <QPainter>
+#include <QPixmapCache>
 
 void KPixmapSequencePrivate::loadSequence(const QPixmap &bigPixmap, const QSize &frameSize)
 {
@@ -38,15 +31,21 @@ void KPixmapSequencePrivate::loadSequence(const QPixmap &bigPixmap, const QSize
 
     const int rowCount = bigPixmap.height() / size.height();
     const int colCount = bigPixmap.width() / size.width();
-    mFrames.resize(rowCount * colCount);
 
-    int pos = 0;
+    // Frames are not copied out, but drawn from the big pixmap directly
+    mAtlas = bigPixmap;
+    mFrameRects.reserve(rowCount * colCount);
     for (int row = 0; row < rowCount; ++row) {
         for (int col = 0; col < colCount; ++col) {
-            QPixmap pix = bigPixmap.copy(col * size.width(), row * size.height(), size.width(), size.height());
-            mFrames[pos++] = pix;
+            mFrameRects.append(QRect(col * size.width(), row * size.height(), size.width(), size.height()));
         }
     }
+    mFrames.resize(mFrameRects.size());
+}
+
+void KPixmapSequencePrivate::paintFrame(QPainter *painter, const QRect &target, int index) const
+{
+    painter->drawPixmap(target, mAtlas, mFrameRects.at(index));
 }
 
 KPixmapSequence::KPixmapSequence()
@@ -68,7 +67,17 @@ KPixmapSequence::KPixmapSequence(const QPixmap &bigPixmap, const QSize &frameSiz
 KPixmapSequence::KPixmapSequence(const QString &fullPath, int size)
     : d(new KPixmapSequencePrivate)
 {
-    d->loadSequence(QPixmap(fullPath), QSize(size, size));
+    // Share the loaded file between all sequences created from it, the
+    // frame size does not matter, as the frames are only rectangles in it
+    const QString cacheKey = QLatin1String("kpixmapsequence_") + fullPath;
+    QPixmap bigPixmap;
+    if (!QPixmapCache::find(cacheKey, &bigPixmap)) {
+        bigPixmap = QPixmap(fullPath);
+        if (!bigPixmap.isNull()) {
+            QPixmapCache::insert(cacheKey, bigPixmap);
+        }
+    }
+    d->loadSequence(bigPixmap, QSize(size, size));
 }
 
 KPixmapSequence::~KPixmapSequence()
@@ -88,7 +97,7 @@ bool KPixmapSequence::isValid() const
 
 bool KPixmapSequence::isEmpty() const
 {
-    return d->mFrames.isEmpty();
+    return d->mFrameRects.isEmpty();
 }
 
 QSize KPixmapSequence::frameSize() const
@@ -97,12 +106,12 @@ QSize KPixmapSequence::frameSize() const
         qCWarning(KWidgetsAddonsLog) << "No frame loaded";
         return QSize();
     }
-    return d->mFrames[0].size();
+    return d->mFrameRects.at(0).size();
 }
 
 int KPixmapSequence::frameCount() const
 {
-    return d->mFrames.size();
+    return d->mFrameRects.size();
 }
 
 QPixmap KPixmapSequence::frameAt(int index) const
@@ -111,5 +120,9 @@ QPixmap KPixmapSequence::frameAt(int index) const
         qCWarning(KWidgetsAddonsLog) << "No frame loaded";
         return QPixmap();
     }
-    return d->mFrames.at(index);
+    QPixmap &frame = d->mFrames[index];
+    if (frame.isNull()) {
+        frame = d->mAtlas.copy(d->mFrameRects.at(index));
+    }
+    return frame;
 }
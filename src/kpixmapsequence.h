@@ -95,6 +95,7 @@ public:
     QPixmap frameAt(int index) const;
 
 private:
+    friend class KPixmapSequencePrivate;
     QSharedDataPointer<class KPixmapSequencePrivate> d;
 };
 
@@ -0,0 +1,41 @@
+/*
+    SPDX-FileCopyrightText: 2008 Aurélien Gâteau <agateau@kde.org>
+    SPDX-FileCopyrightText: 2009 Sebastian Trueg <trueg@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.1-or-later
+*/
+
+#ifndef KPIXMAPSEQUENCE_P_H
+#define KPIXMAPSEQUENCE_P_H
+
+#include "kpixmapsequence.h"
+
+#include <QList>
+#include <QPixmap>
+#include <QRect>
+#include <QSharedData>
+
+class QPainter;
+
+class KPixmapSequencePrivate : public QSharedData
+{
+public:
+    static const KPixmapSequencePrivate *get(const KPixmapSequence &sequence)
+    {
+        return sequence.d.constData();
+    }
+
+    void loadSequence(const QPixmap &bigPixmap, const QSize &frameSize);
+
+    // Draws the frame at index into target, straight from the atlas
+    void paintFrame(QPainter *painter, const QRect &target, int index) const;
+
+    // All frames in one pixmap, as loaded
+    QPixmap mAtlas;
+    // Source rectangle of each frame in the atlas
+    QList<QRect> mFrameRects;
+    // Frames as separate pixmaps, only created when asked for by frameAt()
+    mutable QList<QPixmap> mFrames;
+};
+
+#endif
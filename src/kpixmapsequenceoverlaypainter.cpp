@@ -6,6 +6,7 @@
 
 #include "kpixmapsequenceoverlaypainter.h"
 #include "kpixmapsequence.h"
+#include "kpixmapsequence_p.h"
 
 #include <QCoreApplication>
 #include <QEvent>
@@ -70,7 +71,7 @@ void KPixmapSequenceOverlayPainterPrivate::paintFrame()
         return;
     }
     QPainter p(m_widget);
-    p.drawPixmap(pixmapRect(), sequence().frameAt(m_counter), QRect(QPoint(0, 0), sequence().frameSize()));
+    KPixmapSequencePrivate::get(sequence())->paintFrame(&p, pixmapRect(), m_counter);
 }
 
 KPixmapSequence &KPixmapSequenceOverlayPainterPrivate::sequence()
@@ -7,16 +7,58 @@
 
 #include "kratingpainter.h"
 
+#include "kimageeffects_p.h"
+
+#include <QCache>
+#include <QGlobalStatic>
 #include <QIcon>
 #include <QPainter>
 #include <QPixmap>
 #include <QPoint>
 #include <QRect>
 
+// The star pixmaps needed for painting a rating
+struct KRatingStars {
+    QPixmap rating;
+    QPixmap disabledRating;
+    // Only created once some hover rating is painted
+    QPixmap hover;
+};
+
+namespace
+{
+struct StarsKey {
+    qint64 iconKey;
+    qint64 customPixmapKey;
+    QString themeName;
+    int size;
+    qreal devicePixelRatio;
+    bool enabled;
+
+    bool operator==(const StarsKey &other) const
+    {
+        return iconKey == other.iconKey && customPixmapKey == other.customPixmapKey && size == other.size && devicePixelRatio == other.devicePixelRatio
+            && enabled == other.enabled && themeName == other.themeName;
+    }
+};
+
+size_t qHash(const StarsKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.iconKey, key.customPixmapKey, key.themeName, key.size, key.devicePixelRatio, key.enabled);
+}
+}
+
+// Star pixmaps with the effects for the different states already applied,
+// shared by all painters, as item views paint the same stars in every row.
+using KRatingStarsCache = QCache<StarsKey, KRatingStars>;
+// Few sizes are in use at a time, so the number of entries is bounded
+Q_GLOBAL_STATIC(KRatingStarsCache, s_starsCache, 256)
+
 class KRatingPainterPrivate
 {
 public:
     QPixmap getPixmap(int size, qreal dpr, QIcon::State state = QIcon::On);
+    KRatingStars *stars(int size, qreal dpr);
 
     int maxRating = 10;
     int spacing = 0;
@@ -28,9 +70,6 @@ public:
     QPixmap customPixmap;
 };
 
-static void imageToGrayScale(QImage &img, float value);
-static void imageToSemiTransparent(QImage &img);
-
 QPixmap KRatingPainterPrivate::getPixmap(int size, qreal dpr, QIcon::State state)
 {
     bool transformToOffState = (state == QIcon::Off);
@@ -55,14 +94,39 @@ QPixmap KRatingPainterPrivate::getPixmap(int size, qreal dpr, QIcon::State state
 
     if (transformToOffState) {
         QImage img = p.toImage().convertToFormat(QImage::Format_ARGB32);
-        imageToGrayScale(img, 1.0);
+        KImageEffects::grayscale(img);
         // The icon might have already been monochrome, so we also need to make it semi-transparent to see a difference.
-        imageToSemiTransparent(img);
+        KImageEffects::scaleAlpha(img, 0.5f);
         return QPixmap::fromImage(img);
     }
     return p;
 }
 
+KRatingStars *KRatingPainterPrivate::stars(int size, qreal dpr)
+{
+    // Icons from the theme follow theme changes, so the theme is part of the key
+    StarsKey key{icon.cacheKey(), customPixmap.cacheKey(), icon.isNull() || !icon.name().isEmpty() ? QIcon::themeName() : QString(), size, dpr, isEnabled};
+    if (KRatingStars *stars = s_starsCache()->object(key)) {
+        return stars;
+    }
+
+    auto *stars = new KRatingStars;
+    stars->rating = getPixmap(size, dpr, QIcon::On);
+    stars->disabledRating = getPixmap(size, dpr, QIcon::Off);
+
+    // if we are disabled we become gray and more transparent
+    if (!isEnabled) {
+        stars->rating = stars->disabledRating;
+
+        QImage disabledRatingImage = stars->disabledRating.toImage().convertToFormat(QImage::Format_ARGB32);
+        KImageEffects::scaleAlpha(disabledRatingImage, 0.5f);
+        stars->disabledRating = QPixmap::fromImage(disabledRatingImage);
+    }
+
+    s_starsCache()->insert(std::move(key), stars);
+    return stars;
+}
+
 KRatingPainter::KRatingPainter()
     : d(new KRatingPainterPrivate())
 {
@@ -150,34 +214,6 @@ void KRatingPainter::setSpacing(int s)
     d->spacing = qMax(0, s);
 }
 
-static void imageToGrayScale(QImage &img, float value)
-{
-    QRgb *data = (QRgb *)img.bits();
-    QRgb *end = data + img.width() * img.height();
-
-    unsigned char gray;
-    unsigned char val = (unsigned char)(255.0 * value);
-    while (data != end) {
-        gray = qGray(*data);
-        *data = qRgba((val * gray + (255 - val) * qRed(*data)) >> 8,
-                      (val * gray + (255 - val) * qGreen(*data)) >> 8,
-                      (val * gray + (255 - val) * qBlue(*data)) >> 8,
-                      qAlpha(*data));
-        ++data;
-    }
-}
-
-static void imageToSemiTransparent(QImage &img)
-{
-    QRgb *data = (QRgb *)img.bits();
-    QRgb *end = data + img.width() * img.height();
-
-    while (data != end) {
-        *data = qRgba(qRed(*data), qGreen(*data), qBlue(*data), qAlpha(*data) >> 1);
-        ++data;
-    }
-}
-
 void KRatingPainter::paint(QPainter *painter, const QRect &rect, int rating, int hoverRating) const
 {
     const qreal dpr = painter->device()->devicePixelRatio();
@@ -196,22 +232,14 @@ void KRatingPainter::paint(QPainter *painter, const QRect &rect, int rating, int
 
     // get the rating pixmaps
     int maxHSizeOnePix = (rect.width() - (numUsedStars - 1) * usedSpacing) / numUsedStars;
-    QPixmap ratingPix = d->getPixmap(qMin(rect.height(), maxHSizeOnePix), dpr, QIcon::On);
+    KRatingStars *stars = d->stars(qMin(rect.height(), maxHSizeOnePix), dpr);
+    const QPixmap ratingPix = stars->rating;
 
     QSize ratingPixSize = ratingPix.size() / ratingPix.devicePixelRatio();
 
-    QPixmap disabledRatingPix = d->getPixmap(qMin(rect.height(), maxHSizeOnePix), dpr, QIcon::Off);
-    QImage disabledRatingImage = disabledRatingPix.toImage().convertToFormat(QImage::Format_ARGB32);
+    const QPixmap disabledRatingPix = stars->disabledRating;
     QPixmap hoverPix;
 
-    // if we are disabled we become gray and more transparent
-    if (!d->isEnabled) {
-        ratingPix = disabledRatingPix;
-
-        imageToSemiTransparent(disabledRatingImage);
-        disabledRatingPix = QPixmap::fromImage(disabledRatingImage);
-    }
-
     bool half = d->bHalfSteps && rating % 2;
     int numRatingStars = d->bHalfSteps ? rating / 2 : rating;
 
@@ -221,10 +249,12 @@ void KRatingPainter::paint(QPainter *painter, const QRect &rect, int rating, int
         numHoverStars = d->bHalfSteps ? hoverRating / 2 : hoverRating;
         halfHover = d->bHalfSteps && hoverRating % 2;
 
-        disabledRatingImage = ratingPix.toImage().convertToFormat(QImage::Format_ARGB32);
-        imageToGrayScale(disabledRatingImage, 0.5);
-
-        hoverPix = QPixmap::fromImage(disabledRatingImage);
+        if (stars->hover.isNull()) {
+            QImage hoverImage = ratingPix.toImage().convertToFormat(QImage::Format_ARGB32);
+            KImageEffects::desaturate(hoverImage, 0.5f);
+            stars->hover = QPixmap::fromImage(hoverImage);
+        }
+        hoverPix = stars->hover;
     }
 
     if (d->alignment & Qt::AlignJustify && numUsedStars > 1) {
@@ -5,40 +5,61 @@
 #include "krecentfilesmenu.h"
 
 #include <QGuiApplication>
+#include <QHash>
 #include <QIcon>
+#include <QLineEdit>
 #include <QScreen>
 #include <QSettings>
 #include <QStandardPaths>
+#include <QThreadPool>
+#include <QTimer>
+#include <QWidgetAction>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Time to wait for further changes before writing the list to disk, in ms.
+// Coalesces bursts of changes, like opening many files at once, into a single write.
+static constexpr int s_writeDelay = 500;
+
+using RecentFilesData = std::vector<std::pair<QUrl, QString>>;
+
+static void writeEntries(QSettings &settings, const QString &group, const RecentFilesData &entries)
+{
+    settings.remove(QString());
+    settings.beginGroup(group);
+    settings.beginWriteArray(QStringLiteral("files"));
+
+    int index = 0;
+    for (const auto &[url, displayName] : entries) {
+        settings.setArrayIndex(index);
+        settings.setValue(QStringLiteral("url"), url);
+        settings.setValue(QStringLiteral("displayName"), displayName);
+        ++index;
+    }
+
+    settings.endArray();
+    settings.endGroup();
+    // QSettings replaces the file atomically
+    settings.sync();
+}
 
 class RecentFilesEntry
 {
 public:
     QUrl url;
     QString displayName;
+    // Created on demand, only entries shown in some menu need one
     QAction *action = nullptr;
+    // Higher for more recently added entries
+    quint64 serial = 0;
+    // Generation of the title metrics the action text was elided for, -1 if none yet
+    int titleGeneration = -1;
 
-    QString titleWithSensibleWidth(QWidget *widget) const
+    QString titleWithSensibleWidth(const QFontMetrics &fontMetrics, int maxWidthForTitles) const
     {
         const QString urlString = url.toDisplayString(QUrl::PreferLocalFile);
-        // Calculate 3/4 of screen geometry, we do not want
-        // action titles to be bigger than that
-        // Since we do not know in which screen we are going to show
-        // we choose the min of all the screens
-        int maxWidthForTitles = INT_MAX;
-        const auto screens = QGuiApplication::screens();
-        for (QScreen *screen : screens) {
-            const int width = screen->availableGeometry().width();
-            if (width <= 0) {
-                // Ignore screens with zero width
-                // QGuiApplication::screens() sometimes returns these,
-                // such as on X11 when an xorg.conf ServerLayout refers
-                // to a Screen that is not currently connected.
-                continue;
-            }
-            maxWidthForTitles = qMin(maxWidthForTitles, width * 3 / 4);
-        }
-
-        const QFontMetrics fontMetrics = widget->fontMetrics();
 
         QString title = displayName + QLatin1String(" [") + urlString + QLatin1Char(']');
         const int nameWidth = fontMetrics.boundingRect(title).width();
@@ -60,14 +81,27 @@ public:
         return title;
     }
 
-    explicit RecentFilesEntry(const QUrl &_url, const QString &_displayName, KRecentFilesMenu *menu)
+    QString filterKey() const
+    {
+        return displayName.toCaseFolded();
+    }
+
+    QAction *ensureAction(KRecentFilesMenu *menu)
+    {
+        if (!action) {
+            // The full title is only set once a menu with it is about to be shown
+            action = new QAction(displayName);
+            QObject::connect(action, &QAction::triggered, action, [this, menu]() {
+                Q_EMIT menu->urlTriggered(url);
+            });
+        }
+        return action;
+    }
+
+    explicit RecentFilesEntry(const QUrl &_url, const QString &_displayName)
         : url(_url)
         , displayName(_displayName)
     {
-        action = new QAction(titleWithSensibleWidth(menu));
-        QObject::connect(action, &QAction::triggered, action, [this, menu]() {
-            Q_EMIT menu->urlTriggered(url);
-        });
     }
 
     ~RecentFilesEntry()
@@ -81,36 +115,349 @@ class KRecentFilesMenuPrivate
 public:
     explicit KRecentFilesMenuPrivate(KRecentFilesMenu *q_ptr);
 
-    std::vector<RecentFilesEntry *>::iterator findEntry(const QUrl &url);
+    RecentFilesEntry *addEntry(const QUrl &url, const QString &displayName, quint64 serial);
+    void removeEntry(std::vector<RecentFilesEntry *>::iterator it);
+    void deleteEntries(std::vector<RecentFilesEntry *>::iterator begin);
     void recentFilesChanged() const;
+    void entriesModified();
+
+    static int maximumTitleWidth();
+    void updateTitles();
+
+    std::size_t topPageSize() const;
+    bool isFiltering() const;
+    QList<QAction *> topPageActions();
+    QAction *firstTopPageAction() const;
+    void insertFirstEntryAction();
+    void updateTrailingActions();
+    QMenu *createPageMenu(QMenu *parent, int level);
+
+    void ensurePrefixIndex();
+    void insertIntoPrefixIndex(RecentFilesEntry *entry);
+    void removeFromPrefixIndex(RecentFilesEntry *entry);
+    std::vector<RecentFilesEntry *> filteredEntries();
+
+    RecentFilesData entriesData() const;
+    void writeAsync();
+    void waitForPendingWrites();
 
     KRecentFilesMenu *const q;
     QString m_group = QStringLiteral("RecentFiles");
+    // Ordered by recency, most recent first
     std::vector<RecentFilesEntry *> m_entries;
+    QHash<QUrl, RecentFilesEntry *> m_urlIndex;
+    quint64 m_nextSerial = 1;
     QSettings *m_settings;
     size_t m_maximumItems = 10;
+    int m_pageSize = 0;
     QAction *m_noEntriesAction;
+    QAction *m_separatorAction;
     QAction *m_clearAction;
+    QMenu *m_moreMenu = nullptr;
+    bool m_noEntriesShown = false;
+
+    QWidgetAction *m_filterAction = nullptr;
+    QLineEdit *m_filterLineEdit = nullptr;
+    // Entries sorted by their case folded display name, built on first use of the filter
+    std::vector<std::pair<QString, RecentFilesEntry *>> m_prefixIndex;
+    bool m_prefixIndexValid = false;
+
+    // Metrics the entry titles were last elided for
+    int m_titleWidth = -1;
+    QFont m_titleFont;
+    int m_titleGeneration = 0;
+
+    // Writes are done on a single worker thread, so they happen in order
+    QThreadPool m_writerPool;
+    QTimer m_writeTimer;
+    bool m_modified = false;
 };
 
 KRecentFilesMenuPrivate::KRecentFilesMenuPrivate(KRecentFilesMenu *q_ptr)
     : q(q_ptr)
 {
+    m_writerPool.setMaxThreadCount(1);
+
+    m_writeTimer.setSingleShot(true);
+    m_writeTimer.setInterval(s_writeDelay);
+    QObject::connect(&m_writeTimer, &QTimer::timeout, q, [this]() {
+        writeAsync();
+    });
 }
 
-std::vector<RecentFilesEntry *>::iterator KRecentFilesMenuPrivate::findEntry(const QUrl &url)
+RecentFilesEntry *KRecentFilesMenuPrivate::addEntry(const QUrl &url, const QString &displayName, quint64 serial)
 {
-    return std::find_if(m_entries.begin(), m_entries.end(), [url](RecentFilesEntry *entry) {
-        return entry->url == url;
-    });
+    auto *entry = new RecentFilesEntry(url, displayName);
+    entry->serial = serial;
+    m_urlIndex.insert(url, entry);
+    if (m_prefixIndexValid) {
+        insertIntoPrefixIndex(entry);
+    }
+    return entry;
+}
+
+void KRecentFilesMenuPrivate::removeEntry(std::vector<RecentFilesEntry *>::iterator it)
+{
+    RecentFilesEntry *entry = *it;
+    m_entries.erase(it);
+    m_urlIndex.remove(entry->url);
+    if (m_prefixIndexValid) {
+        removeFromPrefixIndex(entry);
+    }
+    delete entry;
+}
+
+void KRecentFilesMenuPrivate::deleteEntries(std::vector<RecentFilesEntry *>::iterator begin)
+{
+    for (auto it = begin; it != m_entries.end(); ++it) {
+        m_urlIndex.remove((*it)->url);
+        delete *it;
+    }
+    m_entries.erase(begin, m_entries.end());
+    m_prefixIndexValid = false;
+    m_prefixIndex.clear();
 }
 
 void KRecentFilesMenuPrivate::recentFilesChanged() const
 {
-    q->rebuildMenu();
     Q_EMIT q->recentFilesChanged();
 }
 
+void KRecentFilesMenuPrivate::entriesModified()
+{
+    updateTrailingActions();
+
+    m_modified = true;
+    m_writeTimer.start();
+
+    recentFilesChanged();
+}
+
+int KRecentFilesMenuPrivate::maximumTitleWidth()
+{
+    // Calculate 3/4 of screen geometry, we do not want
+    // action titles to be bigger than that
+    // Since we do not know in which screen we are going to show
+    // we choose the min of all the screens
+    int maxWidthForTitles = INT_MAX;
+    const auto screens = QGuiApplication::screens();
+    for (QScreen *screen : screens) {
+        const int width = screen->availableGeometry().width();
+        if (width <= 0) {
+            // Ignore screens with zero width
+            // QGuiApplication::screens() sometimes returns these,
+            // such as on X11 when an xorg.conf ServerLayout refers
+            // to a Screen that is not currently connected.
+            continue;
+        }
+        maxWidthForTitles = qMin(maxWidthForTitles, width * 3 / 4);
+    }
+    return maxWidthForTitles;
+}
+
+void KRecentFilesMenuPrivate::updateTitles()
+{
+    const int maxWidthForTitles = maximumTitleWidth();
+    const QFont font = q->font();
+    if (maxWidthForTitles != m_titleWidth || font != m_titleFont) {
+        m_titleWidth = maxWidthForTitles;
+        m_titleFont = font;
+        ++m_titleGeneration;
+    }
+
+    // Only elide titles which have not been done for the current metrics
+    const QFontMetrics fontMetrics = q->fontMetrics();
+    for (RecentFilesEntry *entry : m_entries) {
+        if (entry->action && entry->titleGeneration != m_titleGeneration) {
+            entry->action->setText(entry->titleWithSensibleWidth(fontMetrics, maxWidthForTitles));
+            entry->titleGeneration = m_titleGeneration;
+        }
+    }
+}
+
+std::size_t KRecentFilesMenuPrivate::topPageSize() const
+{
+    return m_pageSize > 0 ? std::min<std::size_t>(m_pageSize, m_entries.size()) : m_entries.size();
+}
+
+bool KRecentFilesMenuPrivate::isFiltering() const
+{
+    return m_filterLineEdit && !m_filterLineEdit->text().isEmpty();
+}
+
+QList<QAction *> KRecentFilesMenuPrivate::topPageActions()
+{
+    QList<QAction *> actions;
+    if (isFiltering()) {
+        const auto entries = filteredEntries();
+        actions.reserve(entries.size());
+        for (RecentFilesEntry *entry : entries) {
+            actions.append(entry->ensureAction(q));
+        }
+        return actions;
+    }
+
+    const std::size_t count = topPageSize();
+    actions.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        actions.append(m_entries[i]->ensureAction(q));
+    }
+    return actions;
+}
+
+QAction *KRecentFilesMenuPrivate::firstTopPageAction() const
+{
+    const QList<QAction *> actions = q->actions();
+    return actions.value(m_filterAction && actions.value(0) == m_filterAction ? 1 : 0);
+}
+
+void KRecentFilesMenuPrivate::insertFirstEntryAction()
+{
+    updateTrailingActions();
+
+    q->insertAction(firstTopPageAction(), m_entries.front()->ensureAction(q));
+
+    // Keep the page size, the entry pushed out is available on the next page
+    if (m_pageSize > 0 && m_entries.size() > std::size_t(m_pageSize) && m_entries[m_pageSize]->action) {
+        q->removeAction(m_entries[m_pageSize]->action);
+    }
+
+    if (q->isVisible()) {
+        updateTitles();
+    }
+}
+
+void KRecentFilesMenuPrivate::updateTrailingActions()
+{
+    m_moreMenu->menuAction()->setVisible(!isFiltering() && m_pageSize > 0 && m_entries.size() > std::size_t(m_pageSize));
+
+    const bool noEntries = m_entries.empty();
+    if (noEntries == m_noEntriesShown) {
+        return;
+    }
+    m_noEntriesShown = noEntries;
+
+    if (noEntries) {
+        q->removeAction(m_moreMenu->menuAction());
+        q->removeAction(m_separatorAction);
+        q->removeAction(m_clearAction);
+        q->addAction(m_noEntriesAction);
+    } else {
+        q->removeAction(m_noEntriesAction);
+        q->addActions({m_moreMenu->menuAction(), m_separatorAction, m_clearAction});
+    }
+}
+
+// Menu listing the entries of the page at level, and a submenu for the following pages.
+// Filled only when shown, so the actions of older entries are not created before needed.
+QMenu *KRecentFilesMenuPrivate::createPageMenu(QMenu *parent, int level)
+{
+    auto *menu = new QMenu(KRecentFilesMenu::tr("More", "@action:inmenu"), parent);
+    QObject::connect(menu, &QMenu::aboutToShow, menu, [this, menu, level]() {
+        menu->clear();
+        const auto subMenus = menu->findChildren<QMenu *>(Qt::FindDirectChildrenOnly);
+        qDeleteAll(subMenus);
+
+        if (m_pageSize <= 0) {
+            return;
+        }
+        const std::size_t first = std::size_t(level) * m_pageSize;
+        const std::size_t last = std::min(first + m_pageSize, m_entries.size());
+        for (std::size_t i = first; i < last; ++i) {
+            menu->addAction(m_entries[i]->ensureAction(q));
+        }
+        if (last < m_entries.size()) {
+            menu->addMenu(createPageMenu(menu, level + 1));
+        }
+
+        updateTitles();
+    });
+    return menu;
+}
+
+void KRecentFilesMenuPrivate::ensurePrefixIndex()
+{
+    if (m_prefixIndexValid) {
+        return;
+    }
+
+    m_prefixIndex.clear();
+    m_prefixIndex.reserve(m_entries.size());
+    for (RecentFilesEntry *entry : m_entries) {
+        m_prefixIndex.emplace_back(entry->filterKey(), entry);
+    }
+    std::sort(m_prefixIndex.begin(), m_prefixIndex.end());
+    m_prefixIndexValid = true;
+}
+
+void KRecentFilesMenuPrivate::insertIntoPrefixIndex(RecentFilesEntry *entry)
+{
+    std::pair<QString, RecentFilesEntry *> item(entry->filterKey(), entry);
+    const auto it = std::lower_bound(m_prefixIndex.begin(), m_prefixIndex.end(), item);
+    m_prefixIndex.insert(it, std::move(item));
+}
+
+void KRecentFilesMenuPrivate::removeFromPrefixIndex(RecentFilesEntry *entry)
+{
+    const std::pair<QString, RecentFilesEntry *> item(entry->filterKey(), entry);
+    const auto it = std::lower_bound(m_prefixIndex.begin(), m_prefixIndex.end(), item);
+    if (it != m_prefixIndex.end() && it->second == entry) {
+        m_prefixIndex.erase(it);
+    }
+}
+
+std::vector<RecentFilesEntry *> KRecentFilesMenuPrivate::filteredEntries()
+{
+    ensurePrefixIndex();
+
+    const QString prefix = m_filterLineEdit->text().toCaseFolded();
+    auto it = std::lower_bound(m_prefixIndex.cbegin(), m_prefixIndex.cend(), prefix, [](const auto &item, const QString &prefix) {
+        return item.first < prefix;
+    });
+
+    std::vector<RecentFilesEntry *> entries;
+    for (; it != m_prefixIndex.cend() && it->first.startsWith(prefix); ++it) {
+        entries.push_back(it->second);
+    }
+
+    // Most recent matches first, limited to what fits on a page
+    const std::size_t count = m_pageSize > 0 ? std::min<std::size_t>(m_pageSize, entries.size()) : entries.size();
+    std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), [](const RecentFilesEntry *a, const RecentFilesEntry *b) {
+        return a->serial > b->serial;
+    });
+    entries.resize(count);
+    return entries;
+}
+
+RecentFilesData KRecentFilesMenuPrivate::entriesData() const
+{
+    RecentFilesData data;
+    data.reserve(m_entries.size());
+    for (const RecentFilesEntry *entry : m_entries) {
+        data.emplace_back(entry->url, entry->displayName);
+    }
+    return data;
+}
+
+void KRecentFilesMenuPrivate::writeAsync()
+{
+    m_writeTimer.stop();
+    if (!m_modified) {
+        return;
+    }
+    m_modified = false;
+
+    m_writerPool.start([fileName = m_settings->fileName(), group = m_group, data = entriesData()]() {
+        QSettings settings(fileName, QSettings::Format::IniFormat);
+        writeEntries(settings, group, data);
+    });
+}
+
+void KRecentFilesMenuPrivate::waitForPendingWrites()
+{
+    m_writerPool.waitForDone();
+}
+
 KRecentFilesMenu::KRecentFilesMenu(const QString &title, QWidget *parent)
     : QMenu(title, parent)
     , d(new KRecentFilesMenuPrivate(this))
@@ -123,7 +470,37 @@ KRecentFilesMenu::KRecentFilesMenu(const QString &title, QWidget *parent)
     d->m_noEntriesAction = new QAction(tr("No Entries"));
     d->m_noEntriesAction->setDisabled(true);
 
+    d->m_moreMenu = d->createPageMenu(this, 1);
+
+    d->m_separatorAction = new QAction();
+    d->m_separatorAction->setSeparator(true);
+
     d->m_clearAction = new QAction(QIcon::fromTheme(QStringLiteral("edit-clear-history")), tr("Clear List"));
+    // Not using the menu as context, as it disconnects from actions removed from it
+    connect(d->m_clearAction, &QAction::triggered, d->m_clearAction, [this]() {
+        clearRecentFiles();
+    });
+
+    // Eliding the titles needs font metrics, so only do it when they are needed
+    connect(this, &QMenu::aboutToShow, this, [this]() {
+        d->updateTitles();
+        if (d->m_filterLineEdit) {
+            QMetaObject::invokeMethod(
+                d->m_filterLineEdit,
+                [this]() {
+                    d->m_filterLineEdit->setFocus(Qt::PopupFocusReason);
+                },
+                Qt::QueuedConnection);
+        }
+    });
+    connect(this, &QMenu::aboutToHide, this, [this]() {
+        if (d->m_filterLineEdit) {
+            d->m_filterLineEdit->clear();
+        }
+    });
+
+    // Make sure pending changes hit the disk even if the menu is leaked
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &KRecentFilesMenu::writeToFile);
 
     readFromFile();
 }
@@ -138,110 +515,155 @@ KRecentFilesMenu::~KRecentFilesMenu()
     writeToFile();
     qDeleteAll(d->m_entries);
     delete d->m_clearAction;
+    delete d->m_separatorAction;
     delete d->m_noEntriesAction;
+    delete d->m_filterAction;
 }
 
 void KRecentFilesMenu::readFromFile()
 {
-    qDeleteAll(d->m_entries);
-    d->m_entries.clear();
+    // Pick up what was written in the background meanwhile
+    d->waitForPendingWrites();
+    d->m_settings->sync();
+
+    d->deleteEntries(d->m_entries.begin());
 
     d->m_settings->beginGroup(d->m_group);
     const int size = d->m_settings->beginReadArray(QStringLiteral("files"));
 
     d->m_entries.reserve(size);
+    d->m_urlIndex.reserve(size);
 
+    // Only the entries are created here, actions follow once they are shown
     for (int i = 0; i < size; ++i) {
         d->m_settings->setArrayIndex(i);
 
         const QUrl url = d->m_settings->value(QStringLiteral("url")).toUrl();
-        RecentFilesEntry *entry = new RecentFilesEntry(url, d->m_settings->value(QStringLiteral("displayName")).toString(), this);
+        if (d->m_urlIndex.contains(url)) {
+            continue;
+        }
+        RecentFilesEntry *entry = d->addEntry(url, d->m_settings->value(QStringLiteral("displayName")).toString(), size - i);
         d->m_entries.push_back(entry);
     }
+    d->m_nextSerial = size + 1;
 
     d->m_settings->endArray();
     d->m_settings->endGroup();
 
+    rebuildMenu();
     d->recentFilesChanged();
 }
 
 void KRecentFilesMenu::addUrl(const QUrl &url, const QString &name)
 {
-    if (d->m_entries.size() == d->m_maximumItems) {
-        delete d->m_entries.back();
-        d->m_entries.pop_back();
-    }
-
-    // If it's already there remove the old one and reinsert so it appears as new
-    auto it = d->findEntry(url);
-    if (it != d->m_entries.cend()) {
-        delete *it;
-        d->m_entries.erase(it);
-    }
-
     QString displayName = name;
 
     if (displayName.isEmpty()) {
         displayName = url.fileName();
     }
 
-    RecentFilesEntry *entry = new RecentFilesEntry(url, displayName, this);
+    // If it's already there move it to the top so it appears as new
+    RecentFilesEntry *entry = d->m_urlIndex.value(url);
+    if (entry) {
+        d->m_entries.erase(std::find(d->m_entries.begin(), d->m_entries.end(), entry));
+        if (entry->action) {
+            removeAction(entry->action);
+        }
+
+        if (entry->displayName != displayName) {
+            if (d->m_prefixIndexValid) {
+                d->removeFromPrefixIndex(entry);
+            }
+            entry->displayName = displayName;
+            if (d->m_prefixIndexValid) {
+                d->insertIntoPrefixIndex(entry);
+            }
+            if (entry->action) {
+                entry->action->setText(displayName);
+            }
+            entry->titleGeneration = -1;
+        }
+        entry->serial = d->m_nextSerial++;
+    } else {
+        if (!d->m_entries.empty() && d->m_entries.size() >= d->m_maximumItems) {
+            d->removeEntry(d->m_entries.end() - 1);
+        }
+
+        entry = d->addEntry(url, displayName, d->m_nextSerial++);
+    }
+
     d->m_entries.insert(d->m_entries.begin(), entry);
+    if (d->isFiltering()) {
+        rebuildMenu();
+    } else {
+        d->insertFirstEntryAction();
+    }
 
-    d->recentFilesChanged();
+    d->entriesModified();
 }
 
 void KRecentFilesMenu::removeUrl(const QUrl &url)
 {
-    auto it = d->findEntry(url);
-
-    if (it == d->m_entries.end()) {
+    RecentFilesEntry *entry = d->m_urlIndex.value(url);
+    if (!entry) {
         return;
     }
 
-    delete *it;
-    d->m_entries.erase(it);
+    const auto it = std::find(d->m_entries.begin(), d->m_entries.end(), entry);
+    const bool wasOnTopPage = std::size_t(std::distance(d->m_entries.begin(), it)) < d->topPageSize();
+    d->removeEntry(it);
+
+    if (d->isFiltering()) {
+        rebuildMenu();
+    } else if (wasOnTopPage && d->m_pageSize > 0 && d->m_entries.size() >= std::size_t(d->m_pageSize)) {
+        // Fill up the gap with the first entry of the next page
+        insertAction(d->m_moreMenu->menuAction(), d->m_entries[d->m_pageSize - 1]->ensureAction(this));
+        if (isVisible()) {
+            d->updateTitles();
+        }
+    }
 
-    d->recentFilesChanged();
+    d->entriesModified();
 }
 
 void KRecentFilesMenu::rebuildMenu()
 {
-    clear();
-
-    if (d->m_entries.empty()) {
-        addAction(d->m_noEntriesAction);
-        return;
+    // Keep the filter line edit, it might have the focus
+    const QList<QAction *> oldActions = actions();
+    for (QAction *action : oldActions) {
+        if (action != d->m_filterAction) {
+            removeAction(action);
+        }
     }
 
-    for (const RecentFilesEntry *entry : d->m_entries) {
-        addAction(entry->action);
-    }
+    QList<QAction *> actions = d->topPageActions();
 
-    addSeparator();
-    addAction(d->m_clearAction);
+    d->m_noEntriesShown = d->m_entries.empty();
+    if (d->m_noEntriesShown) {
+        actions.append(d->m_noEntriesAction);
+    } else {
+        actions.append({d->m_moreMenu->menuAction(), d->m_separatorAction, d->m_clearAction});
+    }
+    addActions(actions);
+    d->updateTrailingActions();
 
-    // reconnect d->m_clearAction, since it was disconnected in clear()
-    connect(d->m_clearAction, &QAction::triggered, this, &KRecentFilesMenu::clearRecentFiles);
+    if (isVisible()) {
+        d->updateTitles();
+    }
 }
 
 void KRecentFilesMenu::writeToFile()
 {
-    d->m_settings->remove(QString());
-    d->m_settings->beginGroup(d->m_group);
-    d->m_settings->beginWriteArray(QStringLiteral("files"));
+    // Synchronous flush of any pending change, e.g. on shutdown
+    d->m_writeTimer.stop();
+    d->waitForPendingWrites();
 
-    int index = 0;
-    for (const RecentFilesEntry *entry : d->m_entries) {
-        d->m_settings->setArrayIndex(index);
-        d->m_settings->setValue(QStringLiteral("url"), entry->url);
-        d->m_settings->setValue(QStringLiteral("displayName"), entry->displayName);
-        ++index;
+    if (!d->m_modified) {
+        return;
     }
+    d->m_modified = false;
 
-    d->m_settings->endArray();
-    d->m_settings->endGroup();
-    d->m_settings->sync();
+    writeEntries(*d->m_settings, d->m_group, d->entriesData());
 }
 
 QString KRecentFilesMenu::group() const
@@ -251,6 +673,9 @@ QString KRecentFilesMenu::group() const
 
 void KRecentFilesMenu::setGroup(const QString &group)
 {
+    // Pending changes belong to the old group
+    d->writeAsync();
+
     d->m_group = group;
     readFromFile();
 }
@@ -266,10 +691,54 @@ void KRecentFilesMenu::setMaximumItems(size_t maximumItems)
 
     // Truncate if there are more entries than the new maximum
     if (d->m_entries.size() > maximumItems) {
-        qDeleteAll(d->m_entries.begin() + maximumItems, d->m_entries.end());
-        d->m_entries.erase(d->m_entries.begin() + maximumItems, d->m_entries.end());
+        d->deleteEntries(d->m_entries.begin() + maximumItems);
+
+        rebuildMenu();
+        d->entriesModified();
+    }
+}
+
+int KRecentFilesMenu::pageSize() const
+{
+    return d->m_pageSize;
+}
+
+void KRecentFilesMenu::setPageSize(int pageSize)
+{
+    pageSize = std::max(0, pageSize);
+    if (d->m_pageSize == pageSize) {
+        return;
+    }
+    d->m_pageSize = pageSize;
+    rebuildMenu();
+}
+
+bool KRecentFilesMenu::isFilterEnabled() const
+{
+    return d->m_filterAction != nullptr;
+}
 
-        d->recentFilesChanged();
+void KRecentFilesMenu::setFilterEnabled(bool enabled)
+{
+    if (enabled == isFilterEnabled()) {
+        return;
+    }
+
+    if (enabled) {
+        d->m_filterLineEdit = new QLineEdit;
+        d->m_filterLineEdit->setPlaceholderText(tr("Filter…", "@info:placeholder"));
+        d->m_filterLineEdit->setClearButtonEnabled(true);
+        connect(d->m_filterLineEdit, &QLineEdit::textChanged, this, &KRecentFilesMenu::rebuildMenu);
+
+        d->m_filterAction = new QWidgetAction(nullptr);
+        d->m_filterAction->setDefaultWidget(d->m_filterLineEdit);
+        insertAction(actions().value(0), d->m_filterAction);
+    } else {
+        // Also deletes the line edit
+        delete d->m_filterAction;
+        d->m_filterAction = nullptr;
+        d->m_filterLineEdit = nullptr;
+        rebuildMenu();
     }
 }
 
@@ -286,10 +755,10 @@ QList<QUrl> KRecentFilesMenu::recentFiles() const
 
 void KRecentFilesMenu::clearRecentFiles()
 {
-    qDeleteAll(d->m_entries);
-    d->m_entries.clear();
+    d->deleteEntries(d->m_entries.begin());
 
-    d->recentFilesChanged();
+    rebuildMenu();
+    d->entriesModified();
 }
 
 #include "moc_krecentfilesmenu.cpp"
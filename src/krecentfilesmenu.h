@@ -86,6 +86,49 @@ public:
      */
     void setMaximumItems(size_t maximumItems);
 
+    /*!
+     * The number of files shown directly in the menu.
+     *
+     * Older files are reachable through a "More" submenu, which again
+     * holds at most this many files, and so on. The submenus are only
+     * filled once opened, which keeps large lists cheap.
+     *
+     * By default this is 0, meaning all files are shown in the menu itself.
+     *
+     * \sa setPageSize()
+     * \since 6.30
+     */
+    int pageSize() const;
+
+    /*!
+     * Set the number of files shown directly in the menu to \a pageSize.
+     *
+     * \sa pageSize()
+     * \since 6.30
+     */
+    void setPageSize(int pageSize);
+
+    /*!
+     * Whether the menu has a line edit on top to filter the files by name.
+     *
+     * Files whose display name starts with the entered text are shown,
+     * most recent first, and limited to pageSize() if set.
+     *
+     * Disabled by default.
+     *
+     * \sa setFilterEnabled()
+     * \since 6.30
+     */
+    bool isFilterEnabled() const;
+
+    /*!
+     * Set whether the menu has a line edit on top to filter the files by name.
+     *
+     * \sa isFilterEnabled()
+     * \since 6.30
+     */
+    void setFilterEnabled(bool enabled);
+
     /*!
      * List of URLs of recent files.
      *
@@ -8,9 +8,12 @@
 #include "kruler.h"
 
 #include <QFont>
+#include <QPixmap>
 #include <QPolygon>
 #include <QStylePainter>
 
+#include <cmath>
+
 #define INIT_VALUE 0
 #define INIT_MIN_VALUE 0
 #define INIT_MAX_VALUE 100
@@ -53,11 +56,8 @@
 #define END_LABEL_X 4
 #define END_LABEL_Y (END_LABEL_X + LABEL_SIZE - 2)
 
-#undef PROFILING
-
-#ifdef PROFILING
-#include <QDateTime>
-#endif
+#define MIN_TICK_TILE_LENGTH 256 /* tiles shorter than this are repeated within */
+#define MAX_TICK_PERIOD 4096 /* marks repeating after more pixels are not cached */
 
 class KRulerPrivate
 {
@@ -93,8 +93,136 @@ public:
     double ppm; /* pixel per mark */
 
     QString endlabel;
+
+    // What the tick tile was rendered for
+    struct TickTileKey {
+        QSize size;
+        qreal devicePixelRatio = 0.0;
+        QRgb color = 0;
+        double ppm = 0.0;
+        int tmDist = 0;
+        int lmDist = 0;
+        int mmDist = 0;
+        int bmDist = 0;
+        bool showtm = false;
+        bool showlm = false;
+        bool showmm = false;
+        bool showbm = false;
+
+        bool operator==(const TickTileKey &other) const
+        {
+            return size == other.size && devicePixelRatio == other.devicePixelRatio && color == other.color && ppm == other.ppm && tmDist == other.tmDist
+                && lmDist == other.lmDist && mmDist == other.mmDist && bmDist == other.bmDist && showtm == other.showtm && showlm == other.showlm
+                && showmm == other.showmm && showbm == other.showbm;
+        }
+    };
+
+    int tickPeriod() const;
+    void drawMarks(QPainter *p, double start, double end) const;
+    // Returns the tile with the tiny, little, medium and big marks
+    const QPixmap &tickTile(const KRuler *q, int thickness);
+
+    // The marks repeat all along the ruler, so they are rendered once into a tile
+    // which is drawn shifted by the offset
+    QPixmap tickTilePixmap;
+    TickTileKey tickTileKey;
 };
 
+int KRulerPrivate::tickPeriod() const
+{
+    // The marks repeat after the largest distance if that is a multiple of all the other ones
+    const int distances[] = {showtm ? tmDist : 0, showlm ? lmDist : 0, showmm ? mmDist : 0, showbm ? bmDist : 0};
+    int largest = 0;
+    for (int distance : distances) {
+        largest = qMax(largest, distance);
+    }
+    if (largest <= 0) {
+        return 0;
+    }
+    for (int distance : distances) {
+        if (distance > 0 && largest % distance != 0) {
+            return 0;
+        }
+    }
+
+    // Only whole pixels are repeated exactly
+    const double period = ppm * largest;
+    if (period < 1.0 || period > MAX_TICK_PERIOD || std::abs(period - std::round(period)) > 1e-9) {
+        return 0;
+    }
+    return int(std::round(period));
+}
+
+void KRulerPrivate::drawMarks(QPainter *p, double start, double end) const
+{
+    const auto drawMarkLines = [&](int distance, int x1, int x2) {
+        const double fend = ppm * distance;
+        for (int i = 0;; ++i) {
+            const double f = start + i * fend;
+            if (f >= end) {
+                break;
+            }
+            if (dir == Qt::Horizontal) {
+                p->drawLine((int)f, x1, (int)f, x2);
+            } else {
+                p->drawLine(x1, (int)f, x2, (int)f);
+            }
+        }
+    };
+
+    // draw the tiny marks
+    if (showtm) {
+        drawMarkLines(tmDist, BASE_MARK_X1, BASE_MARK_X2);
+    }
+    // draw the little marks
+    if (showlm) {
+        drawMarkLines(lmDist, LITTLE_MARK_X1, LITTLE_MARK_X2);
+    }
+    // draw medium marks
+    if (showmm) {
+        drawMarkLines(mmDist, MIDDLE_MARK_X1, MIDDLE_MARK_X2);
+    }
+    // draw big marks
+    if (showbm) {
+        drawMarkLines(bmDist, BIG_MARK_X1, BIG_MARK_X2);
+    }
+}
+
+const QPixmap &KRulerPrivate::tickTile(const KRuler *q, int thickness)
+{
+    const int period = tickPeriod();
+    const int length = (MIN_TICK_TILE_LENGTH + period - 1) / period * period;
+
+    TickTileKey key;
+    key.size = dir == Qt::Horizontal ? QSize(length, thickness) : QSize(thickness, length);
+    key.devicePixelRatio = q->devicePixelRatioF();
+    key.color = q->palette().color(q->foregroundRole()).rgba();
+    key.ppm = ppm;
+    key.tmDist = tmDist;
+    key.lmDist = lmDist;
+    key.mmDist = mmDist;
+    key.bmDist = bmDist;
+    key.showtm = showtm;
+    key.showlm = showlm;
+    key.showmm = showmm;
+    key.showbm = showbm;
+
+    if (tickTilePixmap.isNull() || !(key == tickTileKey)) {
+        tickTilePixmap = QPixmap(key.size * key.devicePixelRatio);
+        tickTilePixmap.setDevicePixelRatio(key.devicePixelRatio);
+        tickTilePixmap.fill(Qt::transparent);
+
+        QPainter p(&tickTilePixmap);
+        p.setPen(QColor::fromRgba(key.color));
+        drawMarks(&p, 0.0, length);
+        p.end();
+
+        tickTileKey = key;
+    }
+
+    return tickTilePixmap;
+}
+
 KRuler::KRuler(QWidget *parent)
     : QAbstractSlider(parent)
     , d(new KRulerPrivate)
@@ -497,11 +625,13 @@ void KRuler::slotNewValue(int _value)
     if (d->dir == Qt::Horizontal) {
         QRect oldrec(-5 + oldvalue, 10, 11, 6);
         QRect newrec(-5 + _value, 10, 11, 6);
-        repaint(oldrec.united(newrec));
+        update(oldrec);
+        update(newrec);
     } else {
         QRect oldrec(10, -5 + oldvalue, 6, 11);
         QRect newrec(10, -5 + _value, 6, 11);
-        repaint(oldrec.united(newrec));
+        update(oldrec);
+        update(newrec);
     }
 }
 
@@ -510,7 +640,7 @@ void KRuler::slotNewOffset(int _offset)
     if (d->offset != _offset) {
         // setOffset(_offset);
         d->offset = _offset;
-        repaint(contentsRect());
+        update(contentsRect());
     }
 }
 
@@ -524,7 +654,7 @@ void KRuler::slotEndOffset(int offset)
     }
     if (d->endOffset_length != tmp) {
         d->endOffset_length = tmp;
-        repaint(contentsRect());
+        update(contentsRect());
     }
 }
 
@@ -533,131 +663,89 @@ void KRuler::paintEvent(QPaintEvent * /*e*/)
     //  debug ("KRuler::drawContents, %s",(horizontal==dir)?"horizontal":"vertical");
 
     QStylePainter p(this);
-#ifdef PROFILING
-    QTime time;
-    time.start();
-    for (int profile = 0; profile < 10; profile++) {
-#endif
 
-        int value = this->value();
-        int minval = minimum();
-        int maxval;
+    int value = this->value();
+    int minval = minimum();
+    int maxval;
+    if (d->dir == Qt::Horizontal) {
+        maxval = maximum() + d->offset - (d->lengthFix ? (height() - d->endOffset_length) : d->endOffset_length);
+    } else {
+        maxval = maximum() + d->offset - (d->lengthFix ? (width() - d->endOffset_length) : d->endOffset_length);
+    }
+    // ioffsetval = value-offset;
+    //    pixelpm = (int)ppm;
+    //    left  = clip.left(),
+    //    right = clip.right();
+    double offsetmin = (double)(minval - d->offset);
+    double offsetmax = (double)(maxval - d->offset);
+    double fontOffset = (((double)minval) > offsetmin) ? (double)minval : offsetmin;
+
+    // draw labels
+    QFont font = p.font();
+    font.setPointSize(LABEL_SIZE);
+    p.setFont(font);
+    // draw littlemarklabel
+
+    // draw mediummarklabel
+
+    // draw bigmarklabel
+
+    // draw endlabel
+    if (d->showEndL) {
         if (d->dir == Qt::Horizontal) {
-            maxval = maximum() + d->offset - (d->lengthFix ? (height() - d->endOffset_length) : d->endOffset_length);
-        } else {
-            maxval = maximum() + d->offset - (d->lengthFix ? (width() - d->endOffset_length) : d->endOffset_length);
-        }
-        // ioffsetval = value-offset;
-        //    pixelpm = (int)ppm;
-        //    left  = clip.left(),
-        //    right = clip.right();
-        double f;
-        double fend;
-        double offsetmin = (double)(minval - d->offset);
-        double offsetmax = (double)(maxval - d->offset);
-        double fontOffset = (((double)minval) > offsetmin) ? (double)minval : offsetmin;
-
-        // draw labels
-        QFont font = p.font();
-        font.setPointSize(LABEL_SIZE);
-        p.setFont(font);
-        // draw littlemarklabel
-
-        // draw mediummarklabel
-
-        // draw bigmarklabel
-
-        // draw endlabel
-        if (d->showEndL) {
-            if (d->dir == Qt::Horizontal) {
-                p.translate(fontOffset, 0);
-                p.drawText(END_LABEL_X, END_LABEL_Y, d->endlabel);
-            } else { // rotate text +pi/2 and move down a bit
-                // QFontMetrics fm(font);
+            p.translate(fontOffset, 0);
+            p.drawText(END_LABEL_X, END_LABEL_Y, d->endlabel);
+        } else { // rotate text +pi/2 and move down a bit
+            // QFontMetrics fm(font);
 #ifdef KRULER_ROTATE_TEST
-                p.rotate(-90.0 + rotate);
-                p.translate(-8.0 - fontOffset - d->fontWidth + xtrans, ytrans);
+            p.rotate(-90.0 + rotate);
+            p.translate(-8.0 - fontOffset - d->fontWidth + xtrans, ytrans);
 #else
             p.rotate(-90.0);
             p.translate(-8.0 - fontOffset - d->fontWidth, 0.0);
 #endif
-                p.drawText(END_LABEL_X, END_LABEL_Y, d->endlabel);
-            }
-            p.resetTransform();
+            p.drawText(END_LABEL_X, END_LABEL_Y, d->endlabel);
         }
+        p.resetTransform();
+    }
 
-        // draw the tiny marks
-        if (d->showtm) {
-            fend = d->ppm * d->tmDist;
-            for (f = offsetmin; f < offsetmax; f += fend) {
-                if (d->dir == Qt::Horizontal) {
-                    p.drawLine((int)f, BASE_MARK_X1, (int)f, BASE_MARK_X2);
-                } else {
-                    p.drawLine(BASE_MARK_X1, (int)f, BASE_MARK_X2, (int)f);
-                }
-            }
-        }
-        if (d->showlm) {
-            // draw the little marks
-            fend = d->ppm * d->lmDist;
-            for (f = offsetmin; f < offsetmax; f += fend) {
-                if (d->dir == Qt::Horizontal) {
-                    p.drawLine((int)f, LITTLE_MARK_X1, (int)f, LITTLE_MARK_X2);
-                } else {
-                    p.drawLine(LITTLE_MARK_X1, (int)f, LITTLE_MARK_X2, (int)f);
-                }
-            }
-        }
-        if (d->showmm) {
-            // draw medium marks
-            fend = d->ppm * d->mmDist;
-            for (f = offsetmin; f < offsetmax; f += fend) {
-                if (d->dir == Qt::Horizontal) {
-                    p.drawLine((int)f, MIDDLE_MARK_X1, (int)f, MIDDLE_MARK_X2);
-                } else {
-                    p.drawLine(MIDDLE_MARK_X1, (int)f, MIDDLE_MARK_X2, (int)f);
-                }
-            }
-        }
-        if (d->showbm) {
-            // draw big marks
-            fend = d->ppm * d->bmDist;
-            for (f = offsetmin; f < offsetmax; f += fend) {
-                if (d->dir == Qt::Horizontal) {
-                    p.drawLine((int)f, BIG_MARK_X1, (int)f, BIG_MARK_X2);
-                } else {
-                    p.drawLine(BIG_MARK_X1, (int)f, BIG_MARK_X2, (int)f);
-                }
-            }
-        }
-        if (d->showem) {
-            // draw end marks
+    // draw the tiny, little, medium and big marks
+    if (d->tickPeriod() > 0) {
+        if (offsetmax > offsetmin) {
+            const int thickness = d->dir == Qt::Horizontal ? height() : width();
+            const int start = int(offsetmin);
+            const int length = int(offsetmax - offsetmin);
             if (d->dir == Qt::Horizontal) {
-                p.drawLine(minval - d->offset, END_MARK_X1, minval - d->offset, END_MARK_X2);
-                p.drawLine(maxval - d->offset, END_MARK_X1, maxval - d->offset, END_MARK_X2);
+                p.drawTiledPixmap(QRect(start, 0, length, thickness), d->tickTile(this, thickness));
             } else {
-                p.drawLine(END_MARK_X1, minval - d->offset, END_MARK_X2, minval - d->offset);
-                p.drawLine(END_MARK_X1, maxval - d->offset, END_MARK_X2, maxval - d->offset);
+                p.drawTiledPixmap(QRect(0, start, thickness, length), d->tickTile(this, thickness));
             }
         }
-
-        // draw pointer
-        if (d->showpointer) {
-            QPolygon pa(4);
-            if (d->dir == Qt::Horizontal) {
-                pa.setPoints(3, value - 5, 10, value + 5, 10, value /*+0*/, 15);
-            } else {
-                pa.setPoints(3, 10, value - 5, 10, value + 5, 15, value /*+0*/);
-            }
-            p.setBrush(p.background().color());
-            p.drawPolygon(pa);
+    } else {
+        d->drawMarks(&p, offsetmin, offsetmax);
+    }
+    if (d->showem) {
+        // draw end marks
+        if (d->dir == Qt::Horizontal) {
+            p.drawLine(minval - d->offset, END_MARK_X1, minval - d->offset, END_MARK_X2);
+            p.drawLine(maxval - d->offset, END_MARK_X1, maxval - d->offset, END_MARK_X2);
+        } else {
+            p.drawLine(END_MARK_X1, minval - d->offset, END_MARK_X2, minval - d->offset);
+            p.drawLine(END_MARK_X1, maxval - d->offset, END_MARK_X2, maxval - d->offset);
         }
+    }
 
-#ifdef PROFILING
+    // draw pointer
+    if (d->showpointer) {
+        QPolygon pa(4);
+        if (d->dir == Qt::Horizontal) {
+            pa.setPoints(3, value - 5, 10, value + 5, 10, value /*+0*/, 15);
+        } else {
+            pa.setPoints(3, 10, value - 5, 10, value + 5, 15, value /*+0*/);
+        }
+        p.setBrush(p.background().color());
+        p.drawPolygon(pa);
     }
-    int elapsed = time.elapsed();
-    debug("paint time %i", elapsed);
-#endif
 }
 
 #include "moc_kruler.cpp"
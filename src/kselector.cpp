@@ -26,6 +26,28 @@ class KSelectorPrivate
 public:
     bool m_indent = true;
     QStyle::PrimitiveElement arrowPE = QStyle::PE_IndicatorArrowLeft;
+    // Whether to repaint only around the arrow when the value changes,
+    // from where the arrow was painted last
+    bool contentsIndependentOfValue = false;
+    QPoint paintedArrowPos;
+    bool arrowPainted = false;
+};
+
+// What the backdrop of a KGradientSelector was rendered for
+struct KGradientSelectorBackdropKey {
+    QSize size;
+    qreal devicePixelRatio = 0.0;
+    Qt::Orientation orientation = Qt::Horizontal;
+    QGradientStops stops;
+    QString text1;
+    QString text2;
+    QFont font;
+
+    bool operator==(const KGradientSelectorBackdropKey &other) const
+    {
+        return size == other.size && devicePixelRatio == other.devicePixelRatio && orientation == other.orientation && stops == other.stops
+            && text1 == other.text1 && text2 == other.text2 && font == other.font;
+    }
 };
 
 class KGradientSelectorPrivate
@@ -36,10 +58,16 @@ public:
     {
     }
 
+    void renderBackdrop(QPainter *painter, const QRect &rect) const;
+
     KGradientSelector *q;
     QLinearGradient gradient;
     QString text1;
     QString text2;
+
+    // Chessboard, gradient and texts, only rendered again if something of them changed
+    QPixmap backdrop;
+    KGradientSelectorBackdropKey backdropKey;
 };
 
 KSelector::KSelector(QWidget *parent)
@@ -131,6 +159,8 @@ void KSelector::paintEvent(QPaintEvent *)
 
     QPoint pos = calcArrowPos(value());
     drawArrow(&painter, pos);
+    d->paintedArrowPos = pos;
+    d->arrowPainted = true;
 
     painter.end();
 }
@@ -173,7 +203,39 @@ void KSelector::moveArrow(const QPoint &pos)
     }
 
     setValue(val);
-    update();
+}
+
+void KSelector::sliderChange(SliderChange change)
+{
+    if (change != SliderValueChange || !d->contentsIndependentOfValue || !d->arrowPainted) {
+        QAbstractSlider::sliderChange(change);
+        return;
+    }
+
+    // Only the arrow moves
+    update(arrowUpdateRect(d->paintedArrowPos));
+    update(arrowUpdateRect(calcArrowPos(value())));
+}
+
+bool KSelector::contentsIndependentOfValue() const
+{
+    return d->contentsIndependentOfValue;
+}
+
+void KSelector::setContentsIndependentOfValue(bool independent)
+{
+    d->contentsIndependentOfValue = independent;
+}
+
+QRect KSelector::arrowUpdateRect(const QPoint &pos) const
+{
+    // Across the whole widget and with some margin, as drawArrow() might be overridden
+    // to draw a larger arrow than the default one
+    if (orientation() == Qt::Vertical) {
+        return QRect(0, pos.y() - 2 * ARROWSIZE, width(), 4 * ARROWSIZE + 1);
+    } else {
+        return QRect(pos.x() - 2 * ARROWSIZE, 0, 4 * ARROWSIZE + 1, height());
+    }
 }
 
 QPoint KSelector::calcArrowPos(int val)
@@ -280,63 +342,97 @@ KGradientSelector::KGradientSelector(QWidget *parent)
     : KSelector(parent)
     , d(new KGradientSelectorPrivate(this))
 {
+    setContentsIndependentOfValue(true);
 }
 
 KGradientSelector::KGradientSelector(Qt::Orientation o, QWidget *parent)
     : KSelector(o, parent)
     , d(new KGradientSelectorPrivate(this))
 {
+    setContentsIndependentOfValue(true);
 }
 
 KGradientSelector::~KGradientSelector() = default;
 
-void KGradientSelector::drawContents(QPainter *painter)
+static QPixmap chessboardPattern()
 {
-    d->gradient.setStart(contentsRect().topLeft());
-    if (orientation() == Qt::Vertical) {
-        d->gradient.setFinalStop(contentsRect().bottomLeft());
+    QPixmap pattern(16, 16);
+    QPainter patternPainter(&pattern);
+    patternPainter.fillRect(0, 0, 8, 8, Qt::black);
+    patternPainter.fillRect(8, 8, 8, 8, Qt::black);
+    patternPainter.fillRect(0, 8, 8, 8, Qt::white);
+    patternPainter.fillRect(8, 0, 8, 8, Qt::white);
+    patternPainter.end();
+    return pattern;
+}
+
+void KGradientSelectorPrivate::renderBackdrop(QPainter *painter, const QRect &rect) const
+{
+    QLinearGradient gradient = this->gradient;
+    gradient.setStart(rect.topLeft());
+    if (q->orientation() == Qt::Vertical) {
+        gradient.setFinalStop(rect.bottomLeft());
     } else {
-        d->gradient.setFinalStop(contentsRect().topRight());
+        gradient.setFinalStop(rect.topRight());
     }
-    QBrush gradientBrush(d->gradient);
+    QBrush gradientBrush(gradient);
 
     if (!gradientBrush.isOpaque()) {
-        QPixmap chessboardPattern(16, 16);
-        QPainter patternPainter(&chessboardPattern);
-        patternPainter.fillRect(0, 0, 8, 8, Qt::black);
-        patternPainter.fillRect(8, 8, 8, 8, Qt::black);
-        patternPainter.fillRect(0, 8, 8, 8, Qt::white);
-        patternPainter.fillRect(8, 0, 8, 8, Qt::white);
-        patternPainter.end();
-        painter->fillRect(contentsRect(), QBrush(chessboardPattern));
+        painter->fillRect(rect, QBrush(chessboardPattern()));
     }
-    painter->fillRect(contentsRect(), gradientBrush);
+    painter->fillRect(rect, gradientBrush);
 
-    if (orientation() == Qt::Vertical) {
-        int yPos = contentsRect().top() + painter->fontMetrics().ascent() + 2;
-        int xPos = contentsRect().left() + (contentsRect().width() - painter->fontMetrics().horizontalAdvance(d->text2)) / 2;
-        QPen pen(qGray(firstColor().rgb()) > 180 ? Qt::black : Qt::white);
+    const QFontMetrics fm = painter->fontMetrics();
+    if (q->orientation() == Qt::Vertical) {
+        int yPos = rect.top() + fm.ascent() + 2;
+        int xPos = rect.left() + (rect.width() - fm.horizontalAdvance(text2)) / 2;
+        QPen pen(qGray(q->firstColor().rgb()) > 180 ? Qt::black : Qt::white);
         painter->setPen(pen);
-        painter->drawText(xPos, yPos, d->text2);
+        painter->drawText(xPos, yPos, text2);
 
-        yPos = contentsRect().bottom() - painter->fontMetrics().descent() - 2;
-        xPos = contentsRect().left() + (contentsRect().width() - painter->fontMetrics().horizontalAdvance(d->text1)) / 2;
-        pen.setColor(qGray(secondColor().rgb()) > 180 ? Qt::black : Qt::white);
+        yPos = rect.bottom() - fm.descent() - 2;
+        xPos = rect.left() + (rect.width() - fm.horizontalAdvance(text1)) / 2;
+        pen.setColor(qGray(q->secondColor().rgb()) > 180 ? Qt::black : Qt::white);
         painter->setPen(pen);
-        painter->drawText(xPos, yPos, d->text1);
+        painter->drawText(xPos, yPos, text1);
     } else {
-        int yPos = contentsRect().bottom() - painter->fontMetrics().descent() - 2;
+        int yPos = rect.bottom() - fm.descent() - 2;
 
-        QPen pen(qGray(firstColor().rgb()) > 180 ? Qt::black : Qt::white);
+        QPen pen(qGray(q->firstColor().rgb()) > 180 ? Qt::black : Qt::white);
         painter->setPen(pen);
-        painter->drawText(contentsRect().left() + 2, yPos, d->text1);
+        painter->drawText(rect.left() + 2, yPos, text1);
 
-        pen.setColor(qGray(secondColor().rgb()) > 180 ? Qt::black : Qt::white);
+        pen.setColor(qGray(q->secondColor().rgb()) > 180 ? Qt::black : Qt::white);
         painter->setPen(pen);
-        painter->drawText(contentsRect().right() - painter->fontMetrics().horizontalAdvance(d->text2) - 2, yPos, d->text2);
+        painter->drawText(rect.right() - fm.horizontalAdvance(text2) - 2, yPos, text2);
     }
 }
 
+void KGradientSelector::drawContents(QPainter *painter)
+{
+    const QRect rect = contentsRect();
+    if (rect.isEmpty()) {
+        return;
+    }
+
+    KGradientSelectorBackdropKey key{rect.size(), devicePixelRatioF(), orientation(), d->gradient.stops(), d->text1, d->text2, painter->font()};
+    if (d->backdrop.isNull() || !(key == d->backdropKey)) {
+        QPixmap backdrop(rect.size() * key.devicePixelRatio);
+        backdrop.setDevicePixelRatio(key.devicePixelRatio);
+        backdrop.fill(Qt::transparent);
+
+        QPainter backdropPainter(&backdrop);
+        backdropPainter.setFont(key.font);
+        d->renderBackdrop(&backdropPainter, QRect(QPoint(0, 0), rect.size()));
+        backdropPainter.end();
+
+        d->backdrop = backdrop;
+        d->backdropKey = std::move(key);
+    }
+
+    painter->drawPixmap(rect.topLeft(), d->backdrop);
+}
+
 QSize KGradientSelector::minimumSize() const
 {
     return sizeHint();
@@ -106,6 +106,11 @@ protected:
      * The default implementation does nothing.
      *
      * Draw only within contentsRect().
+     *
+     * Unless setContentsIndependentOfValue() was enabled, the whole control
+     * is repainted when the value changes, so the contents may depend on value().
+     * Otherwise only the area around the arrow is repainted then, and the
+     * contents must not depend on value().
      */
     virtual void drawContents(QPainter *);
 
@@ -120,9 +125,32 @@ protected:
     void mouseMoveEvent(QMouseEvent *e) override;
     void mouseReleaseEvent(QMouseEvent *e) override;
     void wheelEvent(QWheelEvent *) override;
+    void sliderChange(SliderChange change) override;
+
+    /*!
+     * Returns whether the contents drawn by drawContents() do not depend on value().
+     *
+     * \sa setContentsIndependentOfValue()
+     * \since 6.30
+     */
+    bool contentsIndependentOfValue() const;
+
+    /*!
+     * Sets whether the contents drawn by drawContents() do not depend on value().
+     *
+     * If \a independent is \c true, a value change only repaints the area around
+     * the old and the new arrow position instead of the whole control.
+     *
+     * Disabled by default. KGradientSelector enables it.
+     *
+     * \sa drawContents()
+     * \since 6.30
+     */
+    void setContentsIndependentOfValue(bool independent);
 
 private:
     KWIDGETSADDONS_NO_EXPORT QPoint calcArrowPos(int val);
+    KWIDGETSADDONS_NO_EXPORT QRect arrowUpdateRect(const QPoint &pos) const;
     KWIDGETSADDONS_NO_EXPORT void moveArrow(const QPoint &pos);
 
 private:
@@ -0,0 +1,164 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "ksqueezedtextdelegate.h"
+
+#include <QAbstractItemView>
+#include <QApplication>
+#include <QCache>
+#include <QGlobalStatic>
+#include <QHelpEvent>
+#include <QStyle>
+#include <QToolTip>
+
+namespace
+{
+struct ElisionKey {
+    QString text;
+    QFont font;
+    int width;
+    Qt::TextElideMode mode;
+
+    bool operator==(const ElisionKey &other) const
+    {
+        return width == other.width && mode == other.mode && text == other.text && font == other.font;
+    }
+};
+
+size_t qHash(const ElisionKey &key, size_t seed = 0)
+{
+    return qHashMulti(seed, key.text, key.font, key.width, int(key.mode));
+}
+}
+
+// Cache of the elided texts, shared by all delegates.
+// Least recently used entries are dropped first, so the ones of the
+// rows currently scrolled into view stay around.
+class KSqueezedTextElisionCache
+{
+public:
+    KSqueezedTextElisionCache();
+
+    QString elidedText(const QString &text, const QFont &font, int width, Qt::TextElideMode mode);
+
+private:
+    QCache<ElisionKey, QString> m_texts;
+};
+
+KSqueezedTextElisionCache::KSqueezedTextElisionCache()
+{
+    // Number of elided texts
+    m_texts.setMaxCost(8192);
+
+    QObject::connect(qGuiApp, &QGuiApplication::fontDatabaseChanged, qGuiApp, [this]() {
+        m_texts.clear();
+    });
+}
+
+QString KSqueezedTextElisionCache::elidedText(const QString &text, const QFont &font, int width, Qt::TextElideMode mode)
+{
+    ElisionKey key{text, font, width, mode};
+    if (const QString *elided = m_texts.object(key)) {
+        return *elided;
+    }
+
+    // Like KSqueezedTextLabel, squeeze each line on its own
+    const QFontMetrics fm(font);
+    QStringList squeezedLines;
+    const auto textLines = text.split(QLatin1Char('\n'));
+    squeezedLines.reserve(textLines.size());
+    for (const QString &line : textLines) {
+        if (fm.boundingRect(line).width() > width) {
+            squeezedLines << fm.elidedText(line, mode, width);
+        } else {
+            squeezedLines << line;
+        }
+    }
+
+    auto *elided = new QString(squeezedLines.join(QLatin1Char('\n')));
+    const QString result = *elided;
+    m_texts.insert(std::move(key), elided);
+    return result;
+}
+
+Q_GLOBAL_STATIC(KSqueezedTextElisionCache, s_elisionCache)
+
+class KSqueezedTextDelegatePrivate
+{
+public:
+    QString squeezedText(const QStyleOptionViewItem &option) const;
+
+    Qt::TextElideMode elideMode = Qt::ElideMiddle;
+};
+
+QString KSqueezedTextDelegatePrivate::squeezedText(const QStyleOptionViewItem &option) const
+{
+    if (option.text.isEmpty() || elideMode == Qt::ElideNone) {
+        return option.text;
+    }
+
+    // Same text rect as used by QCommonStyle for drawing the text
+    const QWidget *widget = option.widget;
+    const QStyle *style = widget ? widget->style() : QApplication::style();
+    const int textMargin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, widget) + 1;
+    const int width = style->subElementRect(QStyle::SE_ItemViewItemText, &option, widget).width() - 2 * textMargin;
+
+    return s_elisionCache()->elidedText(option.text, option.font, width, elideMode);
+}
+
+KSqueezedTextDelegate::KSqueezedTextDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+    , d(new KSqueezedTextDelegatePrivate)
+{
+}
+
+KSqueezedTextDelegate::~KSqueezedTextDelegate() = default;
+
+Qt::TextElideMode KSqueezedTextDelegate::textElideMode() const
+{
+    return d->elideMode;
+}
+
+void KSqueezedTextDelegate::setTextElideMode(Qt::TextElideMode mode)
+{
+    d->elideMode = mode;
+}
+
+void KSqueezedTextDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+
+    // Wrapped text is not squeezed, leave it to the style
+    if (!(opt.features & QStyleOptionViewItem::WrapText)) {
+        opt.text = d->squeezedText(opt);
+        // Already done, do not let the style elide again
+        opt.textElideMode = Qt::ElideNone;
+    }
+
+    const QWidget *widget = opt.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+    style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+}
+
+bool KSqueezedTextDelegate::helpEvent(QHelpEvent *event, QAbstractItemView *view, const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    // A tooltip provided by the model takes precedence
+    if (event && view && event->type() == QEvent::ToolTip && !index.data(Qt::ToolTipRole).isValid()) {
+        QStyleOptionViewItem opt = option;
+        initStyleOption(&opt, index);
+
+        if (!(opt.features & QStyleOptionViewItem::WrapText) && d->squeezedText(opt) != opt.text) {
+            QToolTip::showText(event->globalPos(), opt.text, view->viewport(), opt.rect);
+            return true;
+        }
+    }
+
+    return QStyledItemDelegate::helpEvent(event, view, option, index);
+}
+
+#include "moc_ksqueezedtextdelegate.cpp"
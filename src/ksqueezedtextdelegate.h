@@ -0,0 +1,79 @@
+/*
+    This file is part of the KDE libraries
+    SPDX-FileCopyrightText: 2026 KDE Frameworks contributors
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KSQUEEZEDTEXTDELEGATE_H
+#define KSQUEEZEDTEXTDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <kwidgetsaddons_export.h>
+#include <memory>
+
+/*!
+ * \class KSqueezedTextDelegate
+ * \inmodule KWidgetsAddons
+ *
+ * \brief An item delegate that squeezes the text of items into their cells.
+ *
+ * This is the equivalent of KSqueezedTextLabel for item views: if the
+ * text of an item is too long to fit, it is elided according to
+ * textElideMode(), and hovering the item shows the full text in a tooltip,
+ * unless the model provides a tooltip of its own.
+ *
+ * The elided texts are kept in a size-bounded cache shared by all
+ * delegates of the process, so scrolling through a large view does not
+ * compute the elision of the visible rows on every paint again.
+ *
+ * \code
+ * auto view = new QListView(parent);
+ * view->setItemDelegate(new KSqueezedTextDelegate(view));
+ * \endcode
+ *
+ * \sa KSqueezedTextLabel
+ * \since 6.30
+ */
+class KWIDGETSADDONS_EXPORT KSqueezedTextDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+    /*!
+     * \property KSqueezedTextDelegate::textElideMode
+     */
+    Q_PROPERTY(Qt::TextElideMode textElideMode READ textElideMode WRITE setTextElideMode)
+
+public:
+    /*!
+     * Constructs a squeezed text delegate with the given \a parent.
+     */
+    explicit KSqueezedTextDelegate(QObject *parent = nullptr);
+
+    ~KSqueezedTextDelegate() override;
+
+    /*!
+     * Returns the text elide mode.
+     *
+     * The default is Qt::ElideMiddle.
+     */
+    Qt::TextElideMode textElideMode() const;
+
+    /*!
+     * Sets the text elide mode to \a mode.
+     *
+     * Views using this delegate need to be updated by the caller.
+     */
+    void setTextElideMode(Qt::TextElideMode mode);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+    bool helpEvent(QHelpEvent *event, QAbstractItemView *view, const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+private:
+    std::unique_ptr<class KSqueezedTextDelegatePrivate> const d;
+
+    Q_DISABLE_COPY(KSqueezedTextDelegate)
+};
+
+#endif
@@ -15,6 +15,28 @@
 #include <QScreen>
 #include <QTextDocument>
 
+#include <algorithm>
+#include <vector>
+
+// Elided texts remembered per line, for widths visited before
+static constexpr std::size_t s_maximumElisionsPerLine = 8;
+
+// An elided variant of a line and the range of label widths it is known to be the result for.
+// The elided text fits any width from its own width on, and the longer variants did not fit
+// the widths it was computed for, so any width in between gives the same result.
+struct KSqueezedTextLabelElision {
+    QString text;
+    int minimumWidth;
+    int maximumWidth;
+};
+
+struct KSqueezedTextLabelLine {
+    QString text;
+    int naturalWidth;
+    // Sorted by width, non-overlapping
+    std::vector<KSqueezedTextLabelElision> elisions;
+};
+
 class KSqueezedTextLabelPrivate
 {
 public:
@@ -23,10 +45,91 @@ public:
         QApplication::clipboard()->setText(fullText);
     }
 
+    void invalidateLayout()
+    {
+        lines.clear();
+        squeezedWidth = -1;
+    }
+    void updateLines(const QFontMetrics &fm, const QFont &font);
+    QString elidedLine(KSqueezedTextLabelLine &line, const QFontMetrics &fm, int width) const;
+
     QString fullText;
     Qt::TextElideMode elideMode;
+
+    // Layout cache, valid for fullText, elideMode and lineFont
+    std::vector<KSqueezedTextLabelLine> lines;
+    QFont lineFont;
+    int maximumNaturalWidth = 0;
+    // Label width the current text was squeezed for, -1 if none
+    int squeezedWidth = -1;
+    QString squeezedText;
 };
 
+void KSqueezedTextLabelPrivate::updateLines(const QFontMetrics &fm, const QFont &font)
+{
+    if (!lines.empty() && font == lineFont) {
+        return;
+    }
+
+    lines.clear();
+    lineFont = font;
+    squeezedWidth = -1;
+    maximumNaturalWidth = 0;
+
+    const auto textLines = fullText.split(QLatin1Char('\n'));
+    lines.reserve(textLines.size());
+    for (const QString &text : textLines) {
+        const int naturalWidth = fm.boundingRect(text).width();
+        maximumNaturalWidth = std::max(maximumNaturalWidth, naturalWidth);
+        lines.push_back({text, naturalWidth, {}});
+    }
+}
+
+QString KSqueezedTextLabelPrivate::elidedLine(KSqueezedTextLabelLine &line, const QFontMetrics &fm, int width) const
+{
+    auto &elisions = line.elisions;
+
+    // First elision which could contain the width
+    auto it = std::lower_bound(elisions.begin(), elisions.end(), width, [](const KSqueezedTextLabelElision &elision, int width) {
+        return elision.maximumWidth < width;
+    });
+    if (it != elisions.end() && it->minimumWidth <= width) {
+        return it->text;
+    }
+
+    const QString text = fm.elidedText(line.text, elideMode, width);
+    int textWidth = std::min(fm.horizontalAdvance(text), width);
+    if (it != elisions.begin()) {
+        // Guard against rounding differences in the measurement
+        textWidth = std::max(textWidth, std::prev(it)->maximumWidth + 1);
+    }
+
+    // Widening the range of a known result is all that is needed when moving just past its bounds
+    if (it != elisions.end() && it->text == text) {
+        it->minimumWidth = std::min(it->minimumWidth, textWidth);
+        return text;
+    }
+    if (it != elisions.begin() && std::prev(it)->text == text) {
+        std::prev(it)->maximumWidth = width;
+        return text;
+    }
+
+    if (elisions.size() >= s_maximumElisionsPerLine) {
+        // Drop the one farthest away from the current width
+        const bool dropFront = (width - elisions.front().maximumWidth) > (elisions.back().minimumWidth - width);
+        if (dropFront) {
+            elisions.erase(elisions.begin());
+        } else {
+            elisions.pop_back();
+        }
+        it = std::lower_bound(elisions.begin(), elisions.end(), width, [](const KSqueezedTextLabelElision &elision, int width) {
+            return elision.maximumWidth < width;
+        });
+    }
+    elisions.insert(it, {text, textWidth, width});
+    return text;
+}
+
 KSqueezedTextLabel::KSqueezedTextLabel(const QString &text, QWidget *parent)
     : QLabel(parent)
     , d(new KSqueezedTextLabelPrivate)
@@ -90,40 +193,51 @@ void KSqueezedTextLabel::setMargin(int margin)
 
 void KSqueezedTextLabel::setText(const QString &text)
 {
-    d->fullText = text;
+    if (text != d->fullText) {
+        d->fullText = text;
+        d->invalidateLayout();
+    }
     squeezeTextToLabel();
 }
 
 void KSqueezedTextLabel::clear()
 {
     d->fullText.clear();
+    d->invalidateLayout();
     QLabel::clear();
 }
 
 void KSqueezedTextLabel::squeezeTextToLabel()
 {
-    QFontMetrics fm(fontMetrics());
+    const QFontMetrics fm(fontMetrics());
     const int labelWidth = contentsRect().width();
-    QStringList squeezedLines;
-    bool squeezed = false;
-    const auto textLines = d->fullText.split(QLatin1Char('\n'));
-    squeezedLines.reserve(textLines.size());
-    for (const QString &line : textLines) {
-        int lineWidth = fm.boundingRect(line).width();
-        if (lineWidth > labelWidth) {
-            squeezed = true;
-            squeezedLines << fm.elidedText(line, d->elideMode, labelWidth);
-        } else {
-            squeezedLines << line;
+    d->updateLines(fm, font());
+
+    const bool squeezed = d->maximumNaturalWidth > labelWidth;
+    if (!squeezed) {
+        d->squeezedWidth = -1;
+    } else if (labelWidth != d->squeezedWidth) {
+        QStringList squeezedLines;
+        squeezedLines.reserve(d->lines.size());
+        for (KSqueezedTextLabelLine &line : d->lines) {
+            if (line.naturalWidth > labelWidth) {
+                squeezedLines << d->elidedLine(line, fm, labelWidth);
+            } else {
+                squeezedLines << line.text;
+            }
         }
+        d->squeezedText = squeezedLines.join(QLatin1Char('\n'));
+        d->squeezedWidth = labelWidth;
     }
 
-    if (squeezed) {
-        QLabel::setText(squeezedLines.join(QLatin1Char('\n')));
-        setToolTip(d->fullText);
-    } else {
-        QLabel::setText(d->fullText);
-        setToolTip(QString());
+    // Avoid relayouting the label if nothing changed
+    const QString &shownText = squeezed ? d->squeezedText : d->fullText;
+    if (text() != shownText) {
+        QLabel::setText(shownText);
+    }
+    const QString toolTip = squeezed ? d->fullText : QString();
+    if (this->toolTip() != toolTip) {
+        setToolTip(toolTip);
     }
 }
 
@@ -176,7 +290,10 @@ Qt::TextElideMode KSqueezedTextLabel::textElideMode() const
 
 void KSqueezedTextLabel::setTextElideMode(Qt::TextElideMode mode)
 {
-    d->elideMode = mode;
+    if (d->elideMode != mode) {
+        d->elideMode = mode;
+        d->invalidateLayout();
+    }
     squeezeTextToLabel();
 }
 
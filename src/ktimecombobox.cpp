@@ -6,12 +6,128 @@
 
 #include "ktimecombobox.h"
 
+#include <QAbstractListModel>
 #include <QKeyEvent>
 #include <QLineEdit>
+#include <QStyle>
+#include <QStyleOptionComboBox>
 #include <QTime>
+#include <QtMath>
 
 #include "kmessagebox.h"
 
+class KTimeComboBoxPrivate;
+
+// Model of the drop-down times.
+// The times are computed from their row and only formatted when asked for,
+// so even a list with a one minute interval costs next to nothing until shown.
+class KTimeListModel : public QAbstractListModel
+{
+public:
+    KTimeListModel(KTimeComboBoxPrivate *dd, QObject *parent);
+
+    // The minimum time, every time aligned to the interval from the full hour of the minimum time, and the maximum time
+    void setInterval(const QTime &minTime, const QTime &maxTime, int minutes);
+    // The given sorted times
+    void setTimes(const QList<QTime> &times);
+
+    QTime time(int row) const;
+    // Returns the first row with a time not earlier than time, or rowCount() if there is none
+    int rowForTime(const QTime &time) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    KTimeComboBoxPrivate *const d;
+
+    QList<QTime> m_times;
+    int m_minMSecs = 0;
+    int m_maxMSecs = 0;
+    // Interval times in between are m_baseMSecs + k * m_stepMSecs for k in [m_firstStep, m_firstStep + m_stepCount)
+    int m_baseMSecs = 0;
+    qint64 m_stepMSecs = 0;
+    int m_firstStep = 0;
+    int m_stepCount = 0;
+};
+
+KTimeListModel::KTimeListModel(KTimeComboBoxPrivate *dd, QObject *parent)
+    : QAbstractListModel(parent)
+    , d(dd)
+{
+}
+
+void KTimeListModel::setInterval(const QTime &minTime, const QTime &maxTime, int minutes)
+{
+    beginResetModel();
+    m_times.clear();
+    m_minMSecs = minTime.msecsSinceStartOfDay();
+    m_maxMSecs = maxTime.msecsSinceStartOfDay();
+    m_baseMSecs = minTime.hour() * 3600 * 1000;
+    m_stepMSecs = qint64(minutes) * 60 * 1000;
+    m_firstStep = 0;
+    m_stepCount = 0;
+    if (m_stepMSecs > 0) {
+        // First step after the minimum time, last one before the maximum time
+        m_firstStep = int((m_minMSecs - m_baseMSecs) / m_stepMSecs) + 1;
+        const int endStep = int((m_maxMSecs - m_baseMSecs + m_stepMSecs - 1) / m_stepMSecs);
+        m_stepCount = qMax(0, endStep - m_firstStep);
+    }
+    endResetModel();
+}
+
+void KTimeListModel::setTimes(const QList<QTime> &times)
+{
+    beginResetModel();
+    m_times = times;
+    endResetModel();
+}
+
+QTime KTimeListModel::time(int row) const
+{
+    if (row < 0 || row >= rowCount()) {
+        return QTime();
+    }
+    if (!m_times.isEmpty()) {
+        return m_times.at(row);
+    }
+    if (row == 0) {
+        return QTime::fromMSecsSinceStartOfDay(m_minMSecs);
+    }
+    if (row > m_stepCount) {
+        return QTime::fromMSecsSinceStartOfDay(m_maxMSecs);
+    }
+    return QTime::fromMSecsSinceStartOfDay(int(m_baseMSecs + (m_firstStep + row - 1) * m_stepMSecs));
+}
+
+int KTimeListModel::rowForTime(const QTime &time) const
+{
+    if (!m_times.isEmpty()) {
+        return std::lower_bound(m_times.cbegin(), m_times.cend(), time) - m_times.cbegin();
+    }
+    const int msecs = time.msecsSinceStartOfDay();
+    if (!time.isValid() || msecs <= m_minMSecs) {
+        return 0;
+    }
+    if (msecs > m_maxMSecs) {
+        return rowCount();
+    }
+    if (m_stepCount == 0) {
+        return 1;
+    }
+    // Step not earlier than the time
+    const int step = int((msecs - m_baseMSecs + m_stepMSecs - 1) / m_stepMSecs);
+    return qBound(1, step - m_firstStep + 1, m_stepCount + 1);
+}
+
+int KTimeListModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_times.isEmpty() ? m_stepCount + 2 : m_times.size();
+}
+
 class KTimeComboBoxPrivate
 {
 public:
@@ -27,6 +143,7 @@ public:
 
     void initTimeWidget();
     void updateTimeWidget();
+    QSize contentsSizeHint();
 
     // Private slots
     void selectTime(int index);
@@ -48,8 +165,25 @@ public:
     QLocale::FormatType m_displayFormat;
     int m_timeListInterval;
     QList<QTime> m_timeList;
+    KTimeListModel *m_model = nullptr;
 };
 
+QVariant KTimeListModel::data(const QModelIndex &index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+        return QVariant();
+    }
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        return d->formatTime(time(index.row()));
+    case Qt::UserRole:
+        return time(index.row());
+    default:
+        return QVariant();
+    }
+}
+
 KTimeComboBoxPrivate::KTimeComboBoxPrivate(KTimeComboBox *qq)
     : q(qq)
     , m_time(QTime(0, 0, 0))
@@ -119,13 +253,20 @@ std::pair<QString, QString> KTimeComboBoxPrivate::timeFormatToInputMask(const QS
 
 QTime KTimeComboBoxPrivate::nearestIntervalTime(const QTime &time)
 {
-    int i = 0;
-    while (q->itemData(i).toTime() < time) {
-        ++i;
+    const int count = m_model->rowCount();
+    if (!time.isValid() || count == 0) {
+        return time;
+    }
+    const int i = m_model->rowForTime(time);
+    if (i == 0) {
+        return m_model->time(0);
     }
-    QTime before = q->itemData(i).toTime();
-    QTime after = q->itemData(i + 1).toTime();
-    if (before.secsTo(time) <= time.secsTo(after)) {
+    if (i == count) {
+        return m_model->time(count - 1);
+    }
+    const QTime before = m_model->time(i - 1);
+    const QTime after = m_model->time(i);
+    if (before.msecsTo(time) <= time.msecsTo(after)) {
         return before;
     } else {
         return after;
@@ -140,7 +281,6 @@ QString KTimeComboBoxPrivate::formatTime(const QTime &time)
 void KTimeComboBoxPrivate::initTimeWidget()
 {
     q->blockSignals(true);
-    q->clear();
 
     // Set the input mask from the current format
     QString mask;
@@ -160,33 +300,52 @@ void KTimeComboBoxPrivate::initTimeWidget()
     // Populate the drop-down time list
     // If no time list set the use the time interval
     if (m_timeList.isEmpty()) {
-        QTime startTime = m_minTime;
-        QTime thisTime(startTime.hour(), 0, 0, 0);
-        while (thisTime.isValid() && thisTime <= startTime) {
-            thisTime = thisTime.addSecs(m_timeListInterval * 60);
-        }
-        QTime endTime = m_maxTime;
-        q->addItem(formatTime(startTime), startTime);
-        while (thisTime.isValid() && thisTime < endTime) {
-            q->addItem(formatTime(thisTime), thisTime);
-            QTime newTime = thisTime.addSecs(m_timeListInterval * 60);
-            if (newTime.isValid() && newTime > thisTime) {
-                thisTime = newTime;
-            } else {
-                thisTime = QTime();
-            }
-        }
-        q->addItem(formatTime(endTime), endTime);
+        m_model->setInterval(m_minTime, m_maxTime, m_timeListInterval);
     } else {
+        QList<QTime> times;
         for (const QTime &thisTime : std::as_const(m_timeList)) {
             if (thisTime.isValid() && thisTime >= m_minTime && thisTime <= m_maxTime) {
-                q->addItem(formatTime(thisTime), thisTime);
+                times.append(thisTime);
             }
         }
+        m_model->setTimes(times);
     }
     q->blockSignals(false);
 }
 
+QSize KTimeComboBoxPrivate::contentsSizeHint()
+{
+    // As QComboBox does for AdjustToContents, but without formatting every time of the list
+    QList<QTime> times;
+    if (m_timeList.isEmpty()) {
+        times = {m_minTime, m_maxTime};
+        // Each hour on the hour and late in it, as the digits can differ in width
+        for (int hour = m_minTime.hour(); hour <= m_maxTime.hour(); ++hour) {
+            times.append(QTime(hour, 0, 0));
+            times.append(QTime(hour, 58, 58));
+        }
+    } else {
+        // Given by the application, so usually short
+        for (int i = 0; i < m_model->rowCount(); ++i) {
+            times.append(m_model->time(i));
+        }
+    }
+
+    const QFontMetrics fm = q->fontMetrics();
+    QSize sh;
+    for (const QTime &time : std::as_const(times)) {
+        sh.setWidth(qMax(sh.width(), fm.boundingRect(formatTime(time)).width()));
+    }
+    if (q->minimumContentsLength() > 0) {
+        sh.setWidth(qMax(sh.width(), q->minimumContentsLength() * fm.horizontalAdvance(QLatin1Char('X'))));
+    }
+    sh.setHeight(qMax(qCeil(QFontMetricsF(fm).height()), 14) + 2);
+
+    QStyleOptionComboBox opt;
+    q->initStyleOption(&opt);
+    return q->style()->sizeFromContents(QStyle::CT_ComboBox, &opt, sh, q);
+}
+
 void KTimeComboBoxPrivate::updateTimeWidget()
 {
     q->blockSignals(true);
@@ -198,9 +357,7 @@ void KTimeComboBoxPrivate::updateTimeWidget()
     } else if (m_time > m_maxTime) {
         i = q->count() - 1;
     } else {
-        while (q->itemData(i).toTime() < m_time && i < q->count() - 1) {
-            ++i;
-        }
+        i = qMax(0, qMin(m_model->rowForTime(m_time), q->count() - 1));
     }
     q->setCurrentIndex(i);
     if (m_time.isValid()) {
@@ -268,6 +425,8 @@ KTimeComboBox::KTimeComboBox(QWidget *parent)
     setEditable(true);
     setInsertPolicy(QComboBox::NoInsert);
     setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    d->m_model = new KTimeListModel(d.get(), this);
+    setModel(d->m_model);
     d->initTimeWidget();
     d->updateTimeWidget();
 
@@ -430,7 +589,7 @@ QList<QTime> KTimeComboBox::timeList() const
     int c = count();
     list.reserve(c);
     for (int i = 0; i < c; ++i) {
-        list.append(itemData(i).toTime());
+        list.append(d->m_model->time(i));
     }
     return list;
 }
@@ -450,6 +609,22 @@ void KTimeComboBox::setTimeList(QList<QTime> timeList, const QString &minWarnMsg
     }
 }
 
+QSize KTimeComboBox::sizeHint() const
+{
+    if (sizeAdjustPolicy() != QComboBox::AdjustToContents) {
+        return QComboBox::sizeHint();
+    }
+    return d->contentsSizeHint();
+}
+
+QSize KTimeComboBox::minimumSizeHint() const
+{
+    if (sizeAdjustPolicy() != QComboBox::AdjustToContents) {
+        return QComboBox::minimumSizeHint();
+    }
+    return d->contentsSizeHint();
+}
+
 bool KTimeComboBox::eventFilter(QObject *object, QEvent *event)
 {
     return QComboBox::eventFilter(object, event);
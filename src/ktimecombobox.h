@@ -302,6 +302,17 @@ public Q_SLOTS:
      */
     void setTimeList(QList<QTime> timeList, const QString &minWarnMsg = QString(), const QString &maxWarnMsg = QString());
 
+    /*!
+     * With the default QComboBox::AdjustToContents size adjust policy, the
+     * size is computed from a few representative times, e.g. the minimum and
+     * maximum time and two times of every hour in between, instead of from
+     * every time in the drop-down list.
+     *
+     * \since 6.30
+     */
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
 protected:
     bool eventFilter(QObject *object, QEvent *event) override;
     void showPopup() override;
@@ -25,6 +25,8 @@ class KXYSelectorPrivate
 public:
     KXYSelectorPrivate(KXYSelector *qq)
         : q(qq)
+        , px(0)
+        , py(0)
         , xPos(0)
         , yPos(0)
         , minX(0)
@@ -36,6 +38,7 @@ public:
     }
 
     void setValues(int _xPos, int _yPos);
+    QRect markerUpdateRect(int xp, int yp) const;
 
     KXYSelector *const q;
     int px;
@@ -47,6 +50,13 @@ public:
     int minY;
     int maxY;
     QColor m_markerColor;
+
+    bool contentsCached = false;
+    // The contents drawn by the subclass, with what they were drawn for
+    QPixmap cachedContents;
+    QSize cachedContentsSize;
+    qreal cachedContentsDpr = 0;
+    qint64 paletteCacheKey = 0;
 };
 
 KXYSelector::KXYSelector(QWidget *parent)
@@ -130,6 +140,12 @@ void KXYSelectorPrivate::setValues(int _xPos, int _yPos)
     q->setPosition(xp, yp);
 }
 
+QRect KXYSelectorPrivate::markerUpdateRect(int xp, int yp) const
+{
+    // Generous enough for markers drawn by subclasses as well
+    return QRect(xp - 16, yp - 16, 33, 33);
+}
+
 void KXYSelector::setMarkerColor(const QColor &col)
 {
     d->m_markerColor = col;
@@ -141,6 +157,28 @@ QRect KXYSelector::contentsRect() const
     return rect().adjusted(w, w, -w, -w);
 }
 
+bool KXYSelector::isContentsCached() const
+{
+    return d->contentsCached;
+}
+
+void KXYSelector::setContentsCached(bool cached)
+{
+    if (d->contentsCached == cached) {
+        return;
+    }
+
+    d->contentsCached = cached;
+    d->cachedContents = QPixmap();
+    update();
+}
+
+void KXYSelector::invalidateContents()
+{
+    d->cachedContents = QPixmap();
+    update();
+}
+
 QSize KXYSelector::minimumSizeHint() const
 {
     int w = style()->pixelMetric(QStyle::PM_DefaultFrameWidth);
@@ -153,9 +191,35 @@ void KXYSelector::paintEvent(QPaintEvent * /* ev */)
     opt.initFrom(this);
 
     QPainter painter;
+
+    if (d->contentsCached) {
+        const qreal dpr = devicePixelRatioF();
+        const qint64 paletteCacheKey = palette().cacheKey();
+        // Compared with what was asked for, the pixmap size is rounded at fractional scales
+        if (d->cachedContents.isNull() || d->cachedContentsSize != size() || d->cachedContentsDpr != dpr || d->paletteCacheKey != paletteCacheKey) {
+            d->cachedContents = QPixmap(size() * dpr);
+            d->cachedContents.setDevicePixelRatio(dpr);
+            d->cachedContents.fill(Qt::transparent);
+            d->cachedContentsSize = size();
+            d->cachedContentsDpr = dpr;
+            d->paletteCacheKey = paletteCacheKey;
+
+            painter.begin(&d->cachedContents);
+            // As QPainter does when painting on the widget
+            painter.setPen(palette().color(foregroundRole()));
+            painter.setFont(font());
+            drawContents(&painter);
+            painter.end();
+        }
+    }
+
     painter.begin(this);
 
-    drawContents(&painter);
+    if (d->contentsCached) {
+        painter.drawPixmap(0, 0, d->cachedContents);
+    } else {
+        drawContents(&painter);
+    }
     drawMarker(&painter, d->px, d->py);
 
     style()->drawPrimitive(QStyle::PE_Frame, &opt, &painter, this);
@@ -221,10 +285,18 @@ void KXYSelector::setPosition(int xp, int yp)
         yp = height() - w;
     }
 
+    if (d->contentsCached) {
+        // Only the marker moves over the cached contents
+        if (xp != d->px || yp != d->py) {
+            update(d->markerUpdateRect(d->px, d->py));
+            update(d->markerUpdateRect(xp, yp));
+        }
+    } else {
+        update();
+    }
+
     d->px = xp;
     d->py = yp;
-
-    update();
 }
 
 void KXYSelector::drawContents(QPainter *)
@@ -27,7 +27,8 @@
  * used in KColorDialog.
  *
  * A custom drawing routine for the widget surface has
- * to be provided by the subclass.
+ * to be provided by the subclass. If drawing the surface is expensive,
+ * it can be cached, see setContentsCached().
  */
 class KWIDGETSADDONS_EXPORT KXYSelector : public QWidget
 {
@@ -102,6 +103,31 @@ public:
      */
     QRect contentsRect() const;
 
+    /*!
+     * Returns whether the contents drawn by drawContents() are cached.
+     *
+     * \sa setContentsCached()
+     * \since 6.30
+     */
+    bool isContentsCached() const;
+
+    /*!
+     * Sets whether the contents drawn by drawContents() are cached to \a cached.
+     *
+     * If enabled, drawContents() is only called again after the size, the
+     * device pixel ratio or the palette of the widget changed, or after
+     * invalidateContents(). Moving the marker then only repaints the areas
+     * of the old and the new marker, which are assumed to fit into a
+     * square of 32 by 32 pixels centered at the marker position.
+     *
+     * This is meant for subclasses which draw expensive contents, like a
+     * field of colors. Disabled by default.
+     *
+     * \sa invalidateContents()
+     * \since 6.30
+     */
+    void setContentsCached(bool cached);
+
     QSize minimumSizeHint() const override;
 
 Q_SIGNALS:
@@ -136,6 +162,17 @@ protected:
      */
     void valuesFromPosition(int x, int y, int &xVal, int &yVal) const;
 
+    /*!
+     * Marks the cached contents as outdated and schedules a repaint.
+     *
+     * Subclasses need to call this when the data shown by drawContents()
+     * changed, if the contents are cached.
+     *
+     * \sa setContentsCached()
+     * \since 6.30
+     */
+    void invalidateContents();
+
 private:
     KWIDGETSADDONS_NO_EXPORT void setPosition(int xp, int yp);
 
@@ -10,6 +10,7 @@ int main(int argc, char **argv)
 
     KDateTable widget;
     widget.setCustomDatePainting(QDate::currentDate().addDays(-3), QColor("green"), KDateTable::CircleMode, QColor("yellow"));
+    widget.setCustomDatePainting(QDate::currentDate().addDays(2), QDate::currentDate().addDays(5), QColor("white"), KDateTable::RectangleMode, QColor("blue"));
     widget.show();
 
     return app.exec();